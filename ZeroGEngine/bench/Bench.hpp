@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// Shared helpers for the bench/ and tests/ executables (`make bench`,
+// `make test`). Built with -DNDEBUG like the library, so checks use
+// ZG_CHECK instead of assert.
+
+#define ZG_CHECK(cond)                                                              \
+    do {                                                                            \
+        if (!(cond)) {                                                              \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            std::exit(1);                                                           \
+        }                                                                           \
+    } while (0)
+
+namespace Bench {
+
+    // Keeps `value` (and the work producing it) from being optimized away
+    template <typename T>
+    inline void Keep(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    // Best of `runs` timings of fn(), in milliseconds
+    template <typename Fn>
+    double BestMs(int runs, Fn&& fn) {
+        double best = 1e300;
+        for (int run = 0; run < runs; ++run) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() < best) best = elapsed.count();
+        }
+        return best;
+    }
+
+}  // namespace Bench
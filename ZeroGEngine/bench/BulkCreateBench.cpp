@@ -0,0 +1,58 @@
+// EntityBuilder::BuildMany against a loop of Build() calls: 100k tagged
+// entities with a transform and a physics component, each batch spawned
+// into a fresh world.
+#include "Bench.hpp"
+
+#include "ECS.hpp"
+#include "EntityBuilder.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+    constexpr int Runs = 5;
+    constexpr std::uint32_t Count = 100000;
+
+    EntityBuilder Debris() {
+        PhysicsComponent physics;
+        physics.mass = 2.0f;
+        EntityBuilder builder;
+        builder.WithTag("debris").WithPosition(1.0f, 2.0f, 3.0f).WithPhysics(physics);
+        return builder;
+    }
+
+    // Times spawn(builder) in a world of its own per run; the world is built
+    // and torn down outside the timed section
+    template <typename Spawn>
+    double Time(Spawn&& spawn) {
+        double best = 1e300;
+        for (int run = 0; run < Runs; ++run) {
+            auto world = std::make_unique<World>();
+            ECS::WorldScope scope(*world);
+            EntityBuilder builder = Debris();
+            best = std::min(best, Bench::BestMs(1, [&] { spawn(builder); }));
+
+            ZG_CHECK(world->EntityCount() == Count);
+            ZG_CHECK(world->Storage<TransformComponent>().Size() == Count);
+            ZG_CHECK(world->Storage<PhysicsComponent>().Size() == Count);
+        }
+        return best;
+    }
+
+}  // namespace
+
+int main() {
+    double loop = Time([](EntityBuilder& builder) {
+        for (std::uint32_t i = 0; i < Count; ++i) Bench::Keep(builder.Build());
+    });
+    double batch = Time([](EntityBuilder& builder) {
+        EntityRange range = builder.BuildMany(Count);
+        ZG_CHECK(range.Size() == Count);
+    });
+
+    std::printf("%10s  %-14s %12s\n", "entities", "spawn", "ms");
+    std::printf("%10u  %-14s %12.3f\n", Count, "Build() loop", loop);
+    std::printf("%10u  %-14s %12.3f\n", Count, "BuildMany", batch);
+    return 0;
+}
@@ -0,0 +1,83 @@
+// Sparse-set ComponentPool against the per-type unordered_map store it
+// replaced: a full iteration and a lookup of every entity in shuffled
+// order, at 10k, 100k and 1M entities.
+#include "Bench.hpp"
+
+#include "ComponentPool.hpp"
+#include "TransformComponent.hpp"
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    constexpr int Runs = 5;
+
+    struct Result {
+        double iterate;
+        double lookup;
+    };
+
+    float Sum(const TransformComponent& t) { return t.position.x + t.position.y + t.position.z; }
+
+    Result BenchMap(const std::vector<EntityID>& ids, const std::vector<EntityID>& shuffled) {
+        std::unordered_map<EntityID, TransformComponent> store;
+        for (EntityID id : ids) store[id].position = glm::vec3(float(id), 1.0f, 2.0f);
+
+        Result result;
+        result.iterate = Bench::BestMs(Runs, [&] {
+            float sum = 0.0f;
+            for (const auto& entry : store) sum += Sum(entry.second);
+            Bench::Keep(sum);
+        });
+        result.lookup = Bench::BestMs(Runs, [&] {
+            // the old getters: a find() for Has, then operator[]
+            float sum = 0.0f;
+            for (EntityID id : shuffled) {
+                if (store.find(id) != store.end()) sum += Sum(store[id]);
+            }
+            Bench::Keep(sum);
+        });
+        return result;
+    }
+
+    Result BenchPool(const std::vector<EntityID>& ids, const std::vector<EntityID>& shuffled) {
+        ComponentPool<TransformComponent> pool;
+        for (EntityID id : ids) pool.Emplace(id).position = glm::vec3(float(id), 1.0f, 2.0f);
+
+        Result result;
+        result.iterate = Bench::BestMs(Runs, [&] {
+            float sum = 0.0f;
+            for (const TransformComponent& t : pool) sum += Sum(t);
+            Bench::Keep(sum);
+        });
+        result.lookup = Bench::BestMs(Runs, [&] {
+            float sum = 0.0f;
+            for (EntityID id : shuffled) {
+                if (const TransformComponent* t = pool.Read(id)) sum += Sum(*t);
+            }
+            Bench::Keep(sum);
+        });
+        ZG_CHECK(pool.Size() == ids.size());
+        return result;
+    }
+
+}  // namespace
+
+int main() {
+    std::printf("%10s  %-14s %12s %12s\n", "entities", "store", "iterate ms", "lookup ms");
+    for (std::uint32_t count : {10000u, 100000u, 1000000u}) {
+        std::vector<EntityID> ids(count);
+        for (std::uint32_t i = 0; i < count; ++i) ids[i] = MakeEntityID(i, 0);
+        std::vector<EntityID> shuffled = ids;
+        std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(42));
+
+        Result map = BenchMap(ids, shuffled);
+        Result pool = BenchPool(ids, shuffled);
+        std::printf("%10u  %-14s %12.3f %12.3f\n", count, "unordered_map", map.iterate, map.lookup);
+        std::printf("%10u  %-14s %12.3f %12.3f\n", count, "ComponentPool", pool.iterate, pool.lookup);
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+// CullBoxes over 1M world-space AABBs against one camera frustum, with each
+// kernel this CPU supports. All kernels must agree box for box.
+#include "Bench.hpp"
+
+#include "Frustum.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+    constexpr int Runs = 5;
+    constexpr std::size_t Count = 1000000;
+
+}  // namespace
+
+int main() {
+    // Boxes scattered around the camera, so a fair share of them is visible
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> coord(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> size(0.1f, 5.0f);
+    BoundsSoA boxes;
+    boxes.Reserve(Count);
+    for (std::size_t i = 0; i < Count; ++i) {
+        boxes.Push(glm::vec3(coord(rng), coord(rng), coord(rng)), glm::vec3(size(rng), size(rng), size(rng)));
+    }
+
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 400.0f);
+    Frustum frustum = Frustum::FromMatrix(projection * view);
+
+    std::vector<std::uint8_t> reference(Count), visible(Count);
+    std::size_t referenceCount = CullBoxes(frustum, boxes, reference.data(), SimdPath::Scalar);
+
+    std::printf("%10s  %-8s %12s %20s\n", "boxes", "path", "ms", "visible/total");
+    for (SimdPath path : {SimdPath::Scalar, SimdPath::SSE2, SimdPath::AVX2}) {
+        if (path > ActiveSimdPath()) continue;
+
+        std::size_t count = 0;
+        double ms = Bench::BestMs(Runs, [&] {
+            count = CullBoxes(frustum, boxes, visible.data(), path);
+            Bench::Keep(count);
+        });
+        ZG_CHECK(count == referenceCount);
+        ZG_CHECK(visible == reference);
+
+        std::printf("%10zu  %-8s %12.3f %11zu/%zu\n", Count, SimdPathName(path), ms, count, Count);
+    }
+    return 0;
+}
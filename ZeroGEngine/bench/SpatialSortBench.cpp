@@ -0,0 +1,119 @@
+// Proximity queries over 1M entities spawned in random spatial order, before
+// and after SpatialSort::SortNow(). Each query looks up the transforms and
+// Entity records of everything in the 3x3x3 grid cells around a point, so
+// the pool slots it touches are scattered until the pools are in Z-order.
+// Then runs a pass in DefaultBudget steps and reports the slowest step.
+#include "Bench.hpp"
+
+#include "SpatialSort.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace {
+
+    constexpr int Runs = 5;
+    constexpr std::uint32_t Count = 1000000;
+    constexpr int Queries = 2000;
+    constexpr int Grid = 64; // cells per axis
+    constexpr float WorldSize = 1000.0f;
+
+    int CellOf(float v) { return std::min(Grid - 1, std::max(0, int(v / WorldSize * Grid))); }
+
+    struct CellGrid {
+        std::vector<std::vector<EntityID>> cells = std::vector<std::vector<EntityID>>(Grid * Grid * Grid);
+
+        std::vector<EntityID>& At(int x, int y, int z) { return cells[(z * Grid + y) * Grid + x]; }
+    };
+
+    // Sums distances to every entity in the cells around each query point
+    double Query(World& world, CellGrid& grid, const std::vector<glm::vec3>& points) {
+        auto& transforms = world.Storage<TransformComponent>();
+        auto& entities = world.Storage<Entity>();
+        return Bench::BestMs(Runs, [&] {
+            float sum = 0.0f;
+            for (const glm::vec3& p : points) {
+                int cx = CellOf(p.x), cy = CellOf(p.y), cz = CellOf(p.z);
+                for (int z = std::max(0, cz - 1); z <= std::min(Grid - 1, cz + 1); ++z)
+                    for (int y = std::max(0, cy - 1); y <= std::min(Grid - 1, cy + 1); ++y)
+                        for (int x = std::max(0, cx - 1); x <= std::min(Grid - 1, cx + 1); ++x)
+                            for (EntityID id : grid.At(x, y, z)) {
+                                const TransformComponent* t = transforms.Read(id);
+                                const Entity* e = entities.Read(id);
+                                glm::vec3 d = t->position - p;
+                                sum += d.x * d.x + d.y * d.y + d.z * d.z + float(e->material);
+                            }
+            }
+            Bench::Keep(sum);
+        });
+    }
+
+    bool InMortonOrder(World& world) {
+        const auto& transforms = world.Storage<TransformComponent>();
+        const float scale = float(1u << 10) / WorldSize;
+        auto code = [&](const TransformComponent& t) {
+            auto q = [&](float v) { return std::min(1023u, std::uint32_t(std::max(0.0f, v * scale))); };
+            return SpatialSort::MortonCode(q(t.position.x), q(t.position.y), q(t.position.z));
+        };
+        std::size_t outOfOrder = 0;
+        const TransformComponent* previous = nullptr;
+        for (const TransformComponent& t : transforms) {
+            if (previous && code(t) < code(*previous)) outOfOrder++;
+            previous = &t;
+        }
+        // Bounds come from the data, not [0, WorldSize), so allow a little slack
+        return outOfOrder < transforms.Size() / 100;
+    }
+
+}  // namespace
+
+int main() {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coord(0.0f, WorldSize);
+
+    World world;
+    CellGrid grid;
+    for (std::uint32_t i = 0; i < Count; ++i) {
+        EntityID id = world.CreateEntity();
+        TransformComponent t;
+        t.position = glm::vec3(coord(rng), coord(rng), coord(rng));
+        world.Add(id, t);
+        grid.At(CellOf(t.position.x), CellOf(t.position.y), CellOf(t.position.z)).push_back(id);
+    }
+    std::vector<glm::vec3> points(Queries);
+    for (glm::vec3& p : points) p = glm::vec3(coord(rng), coord(rng), coord(rng));
+
+    SpatialSort sort(world);
+    sort.Follow<Entity>();
+
+    double before = Query(world, grid, points);
+
+    auto start = std::chrono::steady_clock::now();
+    sort.SortNow();
+    std::chrono::duration<double, std::milli> sortNow = std::chrono::steady_clock::now() - start;
+    ZG_CHECK(world.Storage<TransformComponent>().Size() == Count);
+    ZG_CHECK(InMortonOrder(world));
+
+    double after = Query(world, grid, points);
+
+    // A second pass in frame-sized slices
+    std::size_t steps = 0;
+    double worstStep = 0.0;
+    while (sort.Passes() == 1) {
+        start = std::chrono::steady_clock::now();
+        sort.Step();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        worstStep = std::max(worstStep, elapsed.count());
+        steps++;
+    }
+    ZG_CHECK(InMortonOrder(world));
+
+    std::printf("%u entities, %d queries over 3x3x3 cells of a %d^3 grid\n", Count, Queries, Grid);
+    std::printf("  query, spawn order    %10.3f ms\n", before);
+    std::printf("  query, after SortNow  %10.3f ms\n", after);
+    std::printf("  SortNow               %10.3f ms\n", sortNow.count());
+    std::printf("  budgeted pass         %10zu steps, slowest %.3f ms\n", steps, worstStep);
+    return 0;
+}
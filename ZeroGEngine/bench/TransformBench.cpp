@@ -0,0 +1,78 @@
+// Batched TransformSoA composition against one LocalMatrix() (glm::translate,
+// rotate, rotate, rotate, scale) per transform, at 100k transforms. Also
+// checks that both produce the same matrices.
+#include "Bench.hpp"
+
+#include "TransformSoA.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+    constexpr int Runs = 5;
+    constexpr std::size_t Count = 100000;
+    constexpr float Epsilon = 1e-4f;
+
+    std::vector<TransformComponent> RandomTransforms() {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+        std::uniform_real_distribution<float> scale(0.1f, 4.0f);
+
+        std::vector<TransformComponent> transforms(Count);
+        for (TransformComponent& t : transforms) {
+            t.position = glm::vec3(position(rng), position(rng), position(rng));
+            t.rotation = glm::vec3(angle(rng), angle(rng), angle(rng));
+            t.scale = glm::vec3(scale(rng), scale(rng), scale(rng));
+        }
+        return transforms;
+    }
+
+    // Largest element difference, relative to the element's magnitude past 1
+    float MaxError(const glm::mat4& a, const glm::mat4& b) {
+        float worst = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r) {
+                float diff = std::fabs(a[c][r] - b[c][r]) / std::max(1.0f, std::fabs(a[c][r]));
+                worst = std::max(worst, diff);
+            }
+        }
+        return worst;
+    }
+
+}  // namespace
+
+int main() {
+    std::vector<TransformComponent> transforms = RandomTransforms();
+
+    TransformSoA soa;
+    soa.Resize(Count);
+    for (std::size_t i = 0; i < Count; ++i) soa.Set(i, transforms[i]);
+
+    std::vector<glm::mat4> reference(Count);
+    AlignedVector<glm::mat4> batched(soa.PaddedSize());
+
+    double glmMs = Bench::BestMs(Runs, [&] {
+        for (std::size_t i = 0; i < Count; ++i) reference[i] = LocalMatrix(transforms[i]);
+        Bench::Keep(reference.data());
+    });
+    double soaMs = Bench::BestMs(Runs, [&] {
+        ComposeModelMatrices(soa, batched.data());
+        Bench::Keep(batched.data());
+    });
+
+    float worst = 0.0f;
+    for (std::size_t i = 0; i < Count; ++i) worst = std::max(worst, MaxError(reference[i], batched[i]));
+    ZG_CHECK(worst < Epsilon);
+
+    std::printf("%10s  %-22s %12s\n", "transforms", "compose", "ms");
+    std::printf("%10zu  %-22s %12.3f\n", Count, "glm LocalMatrix", glmMs);
+    char label[32];
+    std::snprintf(label, sizeof(label), "TransformSoA (%s)", SimdPathName(ActiveSimdPath()));
+    std::printf("%10zu  %-22s %12.3f\n", Count, label, soaMs);
+    std::printf("max relative error %g\n", worst);
+    return 0;
+}
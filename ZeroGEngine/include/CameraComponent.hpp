@@ -1,4 +1,5 @@
 #pragma once
+#include "Reflection.hpp"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -11,6 +12,13 @@ struct CameraComponent {
     float nearPlane{0.1f};
     float farPlane{100.f};
     glm::vec3 rotation{0.0f, 0.0f, 0.0f}; // pitch, yaw, roll in degrees
+
+    // GetView()/GetProj() return matrices cached by Refresh(), so they are
+    // safe to call from concurrent readers. The setters and updateFront()
+    // refresh; code that writes the fields directly calls Refresh() itself,
+    // and ECS::RefreshCameras() catches the rest once per frame.
+    glm::mat4 cachedView{1.0f};
+    glm::mat4 cachedProj{1.0f};
     
     CameraComponent() { 
         updateFront(); // Make sure default constructor also updates front
@@ -34,6 +42,12 @@ struct CameraComponent {
         front.y = sin(pitch);
         front.z = -cos(pitch) * cos(yaw);
         front = glm::normalize(front);
+        Refresh();
+    }
+
+    void Refresh() {
+        cachedView = glm::lookAt(position, position + front, up);
+        cachedProj = glm::perspective(glm::radians(fov), aspect, nearPlane, farPlane);
     }
     
     // Add method to update rotation and front vector together
@@ -45,13 +59,14 @@ struct CameraComponent {
     // Add method to update position
     void setPosition(const glm::vec3& newPosition) {
         position = newPosition;
+        Refresh();
     }
     
-    glm::mat4 GetView() const { 
-        return glm::lookAt(position, position + front, up); 
-    }
+    const glm::mat4& GetView() const { return cachedView; }
     
-    glm::mat4 GetProj() const { 
-        return glm::perspective(glm::radians(fov), aspect, nearPlane, farPlane); 
-    }
+    const glm::mat4& GetProj() const { return cachedProj; }
 };
+
+// `front` is derived from the rotation; call updateFront() after decoding
+ZG_REFLECT(CameraComponent, ZG_FIELD(position), ZG_FIELD(rotation), ZG_FIELD(up), ZG_FIELD(fov),
+           ZG_FIELD(aspect), ZG_FIELD(nearPlane), ZG_FIELD(farPlane));
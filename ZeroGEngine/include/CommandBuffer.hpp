@@ -0,0 +1,121 @@
+#pragma once
+
+#include "ComponentType.hpp"
+#include "World.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Records structural ECS changes (create, destroy, add/remove component) so
+// they can be issued while iterating pools or from worker threads, then
+// applies them in order in one batch on the world's owning thread. Recording
+// never touches the pools; IDs for new entities are reserved up front, so
+// they can be used in later commands right away.
+//
+// Each thread records into its own buffer (World::Commands()), so recording
+// takes no locks: new IDs come from a block of IDBlockSize indices the buffer
+// claims from the world with a single atomic operation, and components are
+// staged in per-type arrays until playback merges them into the pools.
+class CommandBuffer {
+public:
+    explicit CommandBuffer(World& owner) : world(owner) {}
+
+    // The returned ID becomes live at Playback()
+    EntityID CreateEntity(std::shared_ptr<Mesh> mesh = nullptr, const std::string& tag = "");
+    void DestroyEntity(EntityID id);
+
+    template <typename T>
+    void AddComponent(EntityID id, T&& component) {
+        using C = std::decay_t<T>;
+        auto& staged = Staging<C>();
+        commands.push_back({CommandType::AddComponent, id, ECS::ComponentType<C>(), staged.values.size()});
+        staged.values.push_back(std::forward<T>(component));
+    }
+
+    template <typename T>
+    void RemoveComponent(EntityID id) {
+        Staging<T>(); // playback needs the typed remover
+        commands.push_back({CommandType::RemoveComponent, id, ECS::ComponentType<T>(), 0});
+    }
+
+    // Applies and clears everything recorded so far (owning thread only)
+    void Playback();
+
+    // Hands the rest of the ID block back to the world (owning thread, once
+    // the recording thread is done with this buffer)
+    void ReleaseUnusedIDs();
+
+    bool Empty() const { return commands.empty(); }
+    std::size_t Size() const { return commands.size(); }
+
+    static constexpr std::uint32_t IDBlockSize = 256;
+
+private:
+    enum class CommandType : std::uint8_t { CreateEntity, DestroyEntity, AddComponent, RemoveComponent };
+
+    struct Command {
+        CommandType type;
+        EntityID id;
+        ComponentTypeID component;
+        std::size_t payload; // index into creates or the staged component values
+    };
+
+    struct StagedBase {
+        virtual ~StagedBase() = default;
+        virtual void Reserve(World& world, std::size_t extra) = 0;
+        virtual void Add(World& world, EntityID id, std::size_t payload) = 0;
+        virtual void Remove(World& world, EntityID id) = 0;
+        virtual void Clear() = 0;
+    };
+
+    template <typename T>
+    struct Staged : StagedBase {
+        std::vector<T> values;
+
+        void Reserve(World& world, std::size_t extra) override {
+            auto& pool = world.Storage<T>();
+            pool.Reserve(pool.Size() + extra);
+        }
+        void Add(World& world, EntityID id, std::size_t payload) override {
+            world.Add(id, std::move(values[payload]));
+        }
+        void Remove(World& world, EntityID id) override { world.Remove<T>(id); }
+        void Clear() override { values.clear(); }
+    };
+
+    struct PendingCreate {
+        std::shared_ptr<Mesh> mesh;
+        TagID tag;
+    };
+
+    World& world;
+    std::uint32_t blockNext = 0; // unused part of the ID block: [blockNext, blockEnd)
+    std::uint32_t blockEnd = 0;
+    std::vector<Command> commands;
+    std::vector<PendingCreate> creates;
+    std::vector<std::unique_ptr<StagedBase>> staging; // indexed by ComponentTypeID
+
+    template <typename T>
+    Staged<T>& Staging() {
+        ComponentTypeID type = ECS::ComponentType<T>();
+        if (type >= staging.size()) staging.resize(type + 1);
+        if (!staging[type]) staging[type] = std::make_unique<Staged<T>>();
+        return static_cast<Staged<T>&>(*staging[type]);
+    }
+};
+
+namespace ECS {
+
+    // The calling thread's command buffer for the current world (created on first use)
+    CommandBuffer& Commands();
+
+    // Plays back every thread's buffer for the current world. Call on the
+    // owning thread at a sync point where no system is recording.
+    void FlushCommands();
+
+}  // namespace ECS
@@ -0,0 +1,304 @@
+#pragma once
+
+#include "ComponentType.hpp"
+#include "EntityID.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// True when `tick` is at or after `since`; tolerates the counter wrapping
+constexpr bool TickAtOrAfter(std::uint32_t tick, std::uint32_t since) {
+    return static_cast<std::int32_t>(tick - since) >= 0;
+}
+
+// Type-erased view of a pool, for code that handles every component type
+// (entity destruction, clearing a world, memory accounting, reordering)
+class PoolBase {
+public:
+    virtual ~PoolBase() = default;
+    virtual bool Erase(EntityID id) = 0;
+    virtual void Clear() = 0;
+    virtual std::size_t Size() const = 0;
+
+    // Bytes held by the pool's own arrays (not memory owned by the components)
+    virtual std::size_t MemoryUsage() const = 0;
+
+    // Moves the arrays into right-sized storage and frees empty sparse pages
+    virtual void ShrinkToFit() = 0;
+
+    // Dense slot of the entity's component, or UINT32_MAX if it has none
+    virtual std::uint32_t Slot(EntityID id) const = 0;
+
+    // Exchanges two dense slots; entity -> component lookups stay valid
+    virtual void SwapSlots(std::uint32_t a, std::uint32_t b) = 0;
+};
+
+// Sparse-set storage for one component type.
+// Components live packed in a dense array (iteration is a linear walk) and a
+// paged sparse array maps an entity index to its dense slot (lookup is two
+// loads, no hashing). The dense array stores the full EntityID, so a stale
+// generation for the same index never matches. Removal swaps the last element
+// into the hole.
+//
+// A pool owned by a world also keeps the world's per-entity ComponentMask up
+// to date, so destroying an entity only visits the pools it has.
+//
+// Every slot also carries the tick it was added and last changed at, read
+// from the owning world's clock. Get() is mutable access and stamps the slot
+// as changed; Read() does not. Bulk access through Components() does not
+// stamp either, so call MarkChanged() for anything written that way.
+template <typename T>
+class ComponentPool : public PoolBase {
+public:
+    static constexpr std::size_t PageSize = 4096;
+    static constexpr std::uint32_t Tombstone = UINT32_MAX;
+
+    bool Has(EntityID id) const {
+        return SlotOf(id) != Tombstone;
+    }
+
+    T* Get(EntityID id) {
+        std::uint32_t slot = SlotOf(id);
+        if (slot == Tombstone) return nullptr;
+        changedTicks[slot] = *tickSource;
+        return &components[slot];
+    }
+
+    const T* Read(EntityID id) const {
+        std::uint32_t slot = SlotOf(id);
+        return slot != Tombstone ? &components[slot] : nullptr;
+    }
+
+    const T* Get(EntityID id) const { return Read(id); }
+
+    void MarkChanged(EntityID id) {
+        std::uint32_t slot = SlotOf(id);
+        if (slot != Tombstone) changedTicks[slot] = *tickSource;
+    }
+
+    // Ticks for an entity's component (0 if it has none)
+    std::uint32_t AddedTick(EntityID id) const {
+        std::uint32_t slot = SlotOf(id);
+        return slot != Tombstone ? addedTicks[slot] : 0;
+    }
+
+    std::uint32_t ChangedTick(EntityID id) const {
+        std::uint32_t slot = SlotOf(id);
+        return slot != Tombstone ? changedTicks[slot] : 0;
+    }
+
+    // The world's clock; pools outside a world stay at tick 0
+    void SetTickSource(const std::uint32_t* source) { tickSource = source; }
+
+    // The world's component masks (by entity index) and this pool's bit in them
+    void SetMaskSource(std::vector<ComponentMask>* masks_, ComponentMask bit) {
+        masks = masks_;
+        maskBit = bit;
+    }
+
+    // Inserts a component; if the entity already has one it is left untouched
+    template <typename... Args>
+    T& Emplace(EntityID id, Args&&... args) {
+        std::uint32_t& slot = SparseSlot(id);
+        if (slot != Tombstone) {
+            if (dense[slot] == id) return components[slot];
+
+            // Leftover from an older generation of this index: reuse the slot
+            dense[slot] = id;
+            components[slot] = T(std::forward<Args>(args)...);
+            addedTicks[slot] = changedTicks[slot] = *tickSource;
+            Mark(id, true);
+            if (logAdds) addedLog.push_back(id);
+            return components[slot];
+        }
+
+        slot = static_cast<std::uint32_t>(dense.size());
+        dense.push_back(id);
+        components.emplace_back(std::forward<Args>(args)...);
+        addedTicks.push_back(*tickSource);
+        changedTicks.push_back(*tickSource);
+        Mark(id, true);
+        if (logAdds) addedLog.push_back(id);
+        return components.back();
+    }
+
+    T& Insert(EntityID id, const T& value) { return Emplace(id, value); }
+    T& Insert(EntityID id, T&& value) { return Emplace(id, std::move(value)); }
+
+    bool Erase(EntityID id) override {
+        std::uint32_t slot = SlotOf(id);
+        if (slot == Tombstone) return false;
+
+        std::uint32_t last = static_cast<std::uint32_t>(dense.size() - 1);
+        if (slot != last) {
+            EntityID moved = dense[last];
+            dense[slot] = moved;
+            components[slot] = std::move(components[last]);
+            addedTicks[slot] = addedTicks[last];
+            changedTicks[slot] = changedTicks[last];
+            SparseSlot(moved) = slot;
+        }
+        dense.pop_back();
+        components.pop_back();
+        addedTicks.pop_back();
+        changedTicks.pop_back();
+        SparseSlot(id) = Tombstone;
+        Mark(id, false);
+        if (logRemoves) removedLog.push_back(id);
+        return true;
+    }
+
+    void Clear() override {
+        if (logRemoves) removedLog.insert(removedLog.end(), dense.begin(), dense.end());
+        for (EntityID id : dense) Mark(id, false);
+        sparse.clear();
+        dense.clear();
+        components.clear();
+        addedTicks.clear();
+        changedTicks.clear();
+    }
+
+    // Replaces the whole pool with `count` components copied in bulk from raw,
+    // possibly unaligned arrays (a snapshot). Every slot is stamped as added
+    // at the current tick. Only for trivially copyable T.
+    void Assign(const void* ids, const void* values, std::size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "Assign() copies raw bytes");
+        Clear();
+        dense.resize(count);
+        components.resize(count);
+        if (count > 0) {
+            std::memcpy(dense.data(), ids, count * sizeof(EntityID));
+            std::memcpy(components.data(), values, count * sizeof(T));
+        }
+        addedTicks.assign(count, *tickSource);
+        changedTicks.assign(count, *tickSource);
+
+        for (std::uint32_t slot = 0; slot < count; ++slot) {
+            SparseSlot(dense[slot]) = slot;
+            Mark(dense[slot], true);
+        }
+        if (logAdds) addedLog.insert(addedLog.end(), dense.begin(), dense.end());
+    }
+
+    std::uint32_t Slot(EntityID id) const override { return SlotOf(id); }
+
+    void SwapSlots(std::uint32_t a, std::uint32_t b) override {
+        if (a == b) return;
+        std::swap(dense[a], dense[b]);
+        std::swap(components[a], components[b]);
+        std::swap(addedTicks[a], addedTicks[b]);
+        std::swap(changedTicks[a], changedTicks[b]);
+        SparseSlot(dense[a]) = a;
+        SparseSlot(dense[b]) = b;
+    }
+
+    void Reserve(std::size_t count) {
+        dense.reserve(count);
+        components.reserve(count);
+        addedTicks.reserve(count);
+        changedTicks.reserve(count);
+    }
+
+    std::size_t Size() const override { return dense.size(); }
+    bool Empty() const { return dense.empty(); }
+
+    std::size_t MemoryUsage() const override {
+        std::size_t pages = 0;
+        for (const auto& page : sparse) pages += page ? 1 : 0;
+        return sparse.capacity() * sizeof(sparse[0]) + pages * PageSize * sizeof(std::uint32_t) +
+               dense.capacity() * sizeof(EntityID) + components.capacity() * sizeof(T) +
+               (addedTicks.capacity() + changedTicks.capacity()) * sizeof(std::uint32_t) +
+               (addedLog.capacity() + removedLog.capacity()) * sizeof(EntityID);
+    }
+
+    void ShrinkToFit() override {
+        for (auto& page : sparse) {
+            if (page && std::all_of(page.get(), page.get() + PageSize, [](std::uint32_t slot) { return slot == Tombstone; })) {
+                page.reset();
+            }
+        }
+        while (!sparse.empty() && !sparse.back()) sparse.pop_back();
+        sparse.shrink_to_fit();
+        dense.shrink_to_fit();
+        components.shrink_to_fit();
+        addedTicks.shrink_to_fit();
+        changedTicks.shrink_to_fit();
+        addedLog.shrink_to_fit();
+        removedLog.shrink_to_fit();
+    }
+
+    // Dense arrays, index-aligned: Entities()[i] owns Components()[i]
+    const std::vector<EntityID>& Entities() const { return dense; }
+    std::vector<T>& Components() { return components; }
+    const std::vector<T>& Components() const { return components; }
+    const std::vector<std::uint32_t>& AddedTicks() const { return addedTicks; }
+    const std::vector<std::uint32_t>& ChangedTicks() const { return changedTicks; }
+
+    // Entities that gained / lost the component, recorded only while enabled
+    // (the world enables them for types that have observers)
+    void LogEvents(bool adds, bool removes) {
+        logAdds = adds;
+        logRemoves = removes;
+    }
+    std::vector<EntityID>& AddedLog() { return addedLog; }
+    std::vector<EntityID>& RemovedLog() { return removedLog; }
+
+    typename std::vector<T>::iterator begin() { return components.begin(); }
+    typename std::vector<T>::iterator end() { return components.end(); }
+    typename std::vector<T>::const_iterator begin() const { return components.begin(); }
+    typename std::vector<T>::const_iterator end() const { return components.end(); }
+
+private:
+    std::vector<std::unique_ptr<std::uint32_t[]>> sparse;
+    std::vector<EntityID> dense;
+    std::vector<T> components;
+    std::vector<std::uint32_t> addedTicks;
+    std::vector<std::uint32_t> changedTicks;
+
+    bool logAdds = false;
+    bool logRemoves = false;
+    std::vector<EntityID> addedLog;
+    std::vector<EntityID> removedLog;
+
+    static constexpr std::uint32_t NoClock = 0;
+    const std::uint32_t* tickSource = &NoClock;
+
+    std::vector<ComponentMask>* masks = nullptr;
+    ComponentMask maskBit = 0;
+
+    void Mark(EntityID id, bool has) {
+        std::uint32_t index = EntityIndex(id);
+        if (!masks || index >= masks->size()) return;
+        if (has) {
+            (*masks)[index] |= maskBit;
+        } else {
+            (*masks)[index] &= ~maskBit;
+        }
+    }
+
+    std::uint32_t SlotOf(EntityID id) const {
+        std::uint32_t index = EntityIndex(id);
+        std::size_t page = index / PageSize;
+        if (page >= sparse.size() || !sparse[page]) return Tombstone;
+        std::uint32_t slot = sparse[page][index % PageSize];
+        return (slot != Tombstone && dense[slot] == id) ? slot : Tombstone;
+    }
+
+    // Returns the sparse entry for id's index, allocating its page on first use
+    std::uint32_t& SparseSlot(EntityID id) {
+        std::uint32_t index = EntityIndex(id);
+        std::size_t page = index / PageSize;
+        if (page >= sparse.size()) sparse.resize(page + 1);
+        if (!sparse[page]) {
+            sparse[page].reset(new std::uint32_t[PageSize]);
+            std::fill_n(sparse[page].get(), PageSize, Tombstone);
+        }
+        return sparse[page][index % PageSize];
+    }
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Small dense integer per component type, handed out on first use.
+// Used wherever component types need to be compared or stored at runtime
+// (scheduler read/write sets, per-type tables).
+using ComponentTypeID = std::uint32_t;
+
+// One bit per component type an entity has, for the first MaskedTypes type
+// IDs (later types are looked up in their pools instead)
+using ComponentMask = std::uint64_t;
+constexpr ComponentTypeID MaskedTypes = 64;
+
+constexpr ComponentMask ComponentBit(ComponentTypeID type) {
+    return type < MaskedTypes ? ComponentMask(1) << type : 0;
+}
+
+namespace ECS {
+
+    namespace detail {
+        inline ComponentTypeID NextComponentTypeID() {
+            static std::atomic<ComponentTypeID> next{0};
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+    }  // namespace detail
+
+    template <typename T>
+    ComponentTypeID ComponentType() {
+        static const ComponentTypeID id = detail::NextComponentTypeID();
+        return id;
+    }
+
+}  // namespace ECS
@@ -3,48 +3,144 @@
 #include "TransformComponent.hpp"
 #include "PhysicsComponent.hpp"
 #include "CameraComponent.hpp"
+#include "HierarchyComponent.hpp"
+#include "ComponentPool.hpp"
 #include "Entity.hpp"
+#include "World.hpp"
 #include "glad/glad.h"
 
 
-#include <unordered_map>
 #include <optional>
+#include <string_view>
+#include <utility>
 
+// Free-function front end over a World. Every call goes to the calling
+// thread's current world, which is the process-wide default world unless a
+// WorldScope (or SetCurrentWorld) says otherwise.
 namespace ECS {
 
+    // World selection
+    World& DefaultWorld();
+    void SetCurrentWorld(World* world); // nullptr restores the default world
+
+    namespace detail {
+        extern thread_local World* currentWorld;
+    }
+
+    inline World& CurrentWorld() {
+        return detail::currentWorld ? *detail::currentWorld : DefaultWorld();
+    }
+
+    // Binds the calling thread to a world for the lifetime of the scope
+    class WorldScope {
+    public:
+        explicit WorldScope(World& world) : previous(detail::currentWorld) { detail::currentWorld = &world; }
+        ~WorldScope() { detail::currentWorld = previous; }
+        WorldScope(const WorldScope&) = delete;
+        WorldScope& operator=(const WorldScope&) = delete;
+
+    private:
+        World* previous;
+    };
+
     // Entity management
     EntityID CreateEntity(std::shared_ptr<Mesh> mesh = nullptr, const std::string& tag = "");
+
+    // Creates `count` entities with consecutive IDs in one go
+    EntityRange CreateEntities(std::uint32_t count, std::shared_ptr<Mesh> mesh = nullptr, const std::string& tag = "");
+
+    // Claims a fresh ID without creating the entity; safe from any thread.
+    // The entity becomes live once CreateReservedEntity() runs on the owning thread.
+    EntityID ReserveEntity();
+    bool CreateReservedEntity(EntityID id, std::shared_ptr<Mesh> mesh = nullptr, const std::string& tag = "");
     bool HasEntity(EntityID id);
     Entity* GetEntity(EntityID id);
     void DestroyEntity(EntityID id);
     void Clear();
-    
+
     // Component management
     void AddPhysics(EntityID id, const PhysicsComponent& p);
     PhysicsComponent* GetPhysics(EntityID id);
     bool HasPhysics(EntityID id);
-    
+
     void AddTransform(EntityID id, const TransformComponent& t);
     TransformComponent* GetTransform(EntityID id);
     bool HasTransform(EntityID id);
-    
+
     void AddCamera(EntityID id, const CameraComponent& c);
     CameraComponent* GetCamera(EntityID id);
     bool HasCamera(EntityID id);
+    // Rebuilds every camera's cached matrices; run before the frame's systems
+    void RefreshCameras();
+
+    // Transform hierarchy. NullEntity detaches; links that would form a cycle
+    // (or point at a dead entity) are refused.
+    bool SetParent(EntityID child, EntityID parent);
+    EntityID GetParent(EntityID child);
 
     // Entity tagging
-    std::string GetTag(EntityID id);
+    const std::string& GetTag(EntityID id);
     void SetTag(EntityID id, const std::string& tag);
 
+    // Entities with a tag, straight from the tag index (O(matches))
+    const std::vector<EntityID>& FindByTag(std::string_view tag);
+
+    // fn(EntityID) for each entity with the tag; fn may destroy or retag it
+    template<typename Func>
+    void ForEachWithTag(std::string_view tag, Func&& fn) {
+        CurrentWorld().ForEachWithTag(tag, std::forward<Func>(fn));
+    }
+
     // Iterating over all entities
-    const std::unordered_map<EntityID, Entity>& GetAllEntities();
+    const ComponentPool<Entity>& GetAllEntities();
 
-    // Component getter
+    // Utility functions
     template<typename T>
-    T* GetComponent(EntityID id);
+    ComponentPool<T>& componentStorage() {
+        return CurrentWorld().Storage<T>();
+    }
+
+    // Generic component access
+    template<typename T>
+    T* GetComponent(EntityID id) {
+        return CurrentWorld().Get<T>(id);
+    }
+
+    // Read-only access; does not mark the component as changed
+    template<typename T>
+    const T* ReadComponent(EntityID id) {
+        return CurrentWorld().Read<T>(id);
+    }
+
+    template<typename T>
+    bool HasComponent(EntityID id) {
+        return CurrentWorld().Has<T>(id);
+    }
+
+    template<typename T>
+    void AddComponent(EntityID id, T&& component) {
+        CurrentWorld().Add(id, std::forward<T>(component));
+    }
+
+    template<typename T>
+    void AddComponents(const EntityRange& range, const T& component) {
+        CurrentWorld().AddMany(range, component);
+    }
+
+    template<typename T>
+    void RemoveComponent(EntityID id) {
+        CurrentWorld().Remove<T>(id);
+    }
+
+    // Lifecycle observers on the current world (see World::OnAdd)
+    template<typename T>
+    ObserverID OnAdd(ObserverFn fn) {
+        return CurrentWorld().OnAdd<T>(std::move(fn));
+    }
 
-    // Utility functions
     template<typename T>
-    std::unordered_map<EntityID, T>& componentStorage();
+    ObserverID OnRemove(ObserverFn fn) {
+        return CurrentWorld().OnRemove<T>(std::move(fn));
+    }
 
 }  // namespace ECS
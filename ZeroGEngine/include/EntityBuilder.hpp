@@ -1,9 +1,11 @@
 #pragma once
 #include "CameraComponent.hpp"
 #include "ECS.hpp"
+#include "MeshRegistry.hpp"
 #include "MeshType.hpp"
 #include "PhysicsComponent.hpp"
 #include "PhysicsOptions.hpp"
+#include "Prefab.hpp"
 #include "TransformComponent.hpp"
 #include <memory>
 #include <optional>
@@ -12,20 +14,28 @@ class EntityBuilder {
 
   std::optional<MeshType>
       meshType; // instead of MeshType meshType{MeshType::Cube};
+  MeshParams meshParams;
   TransformComponent transform;
   std::string tag;
   std::optional<PhysicsComponent> physics; // optional physics
   std::optional<CameraComponent> camera;
+  std::optional<std::string> texturePath;
+  EntityID parent = NullEntity;
 
 public:
-  EntityBuilder &WithMesh(MeshType m) {
+  EntityBuilder &WithMesh(MeshType m, const MeshParams &params = MeshParams()) {
     meshType = m;
+    meshParams = params;
     return *this;
   }
   EntityBuilder &WithTag(const std::string &t) {
     tag = t;
     return *this;
   }
+  EntityBuilder &WithTransform(const TransformComponent &t) {
+    transform = t;
+    return *this;
+  }
   EntityBuilder &WithPosition(float x, float y, float z = 0.f) {
     transform.position = {x, y, z};
     return *this;
@@ -44,20 +54,26 @@ public:
     return *this;
   }
 
-EntityBuilder& EntityBuilder::WithTexture(const std::string& texturePath) {
-    ECS::AddComponent<TextureComponent>(entityId, TextureComponent(texturePath));
+  EntityBuilder &WithTexture(const std::string &path) {
+    texturePath = path;
     return *this;
-}
+  }
   // NEW: set physics creation options (convenience)
   EntityBuilder &WithPhysicsOptions(const PhysicsOptions &opts) {
     PhysicsComponent p;
-    p.options = std::make_shared<PhysicsOptions>(opts);
+    p.options = PhysicsOptions::Intern(opts);
     p.mass = opts.mass;
     p.isStatic = opts.isStatic;
     physics = p;
     return *this;
   }
 
+  // Transform becomes relative to the parent's
+  EntityBuilder &WithParent(EntityID p) {
+    parent = p;
+    return *this;
+  }
+
   EntityBuilder &WithCamera(const CameraComponent &c) {
     camera = c;
     return *this;
@@ -67,7 +83,7 @@ EntityBuilder& EntityBuilder::WithTexture(const std::string& texturePath) {
     std::shared_ptr<Mesh> mesh = nullptr;
 
     if (meshType.has_value()) {
-      mesh = std::make_shared<Mesh>(meshType.value());
+      mesh = MeshRegistry::Get(meshType.value(), meshParams);
     }
 
     EntityID id = ECS::CreateEntity(mesh, tag);
@@ -77,7 +93,78 @@ EntityBuilder& EntityBuilder::WithTexture(const std::string& texturePath) {
       ECS::AddPhysics(id, physics.value());
     if (camera.has_value())
       ECS::AddCamera(id, camera.value());
+    if (parent != NullEntity)
+      ECS::SetParent(id, parent);
+    if (texturePath.has_value()) {
+      TextureComponent texture(texturePath.value());
+      texture.LoadTexture();
+      if (Entity *entity = ECS::GetEntity(id))
+        entity->material = texture.textureID;
+      ECS::AddComponent(id, std::move(texture));
+    }
 
     return id;
   }
+
+  // Spawns `count` copies in one batch: consecutive IDs, one shared mesh and
+  // texture, and each component pool grown once instead of per entity.
+  // initFn(i, id, transform) adjusts each copy's transform (e.g. to scatter
+  // debris) before physics or camera components are attached.
+  template <typename InitFn>
+  EntityRange BuildMany(std::uint32_t count, InitFn &&initFn) {
+    std::shared_ptr<Mesh> mesh = nullptr;
+
+    if (meshType.has_value()) {
+      mesh = MeshRegistry::Get(meshType.value(), meshParams);
+    }
+
+    EntityRange range = ECS::CreateEntities(count, mesh, tag);
+    if (range.Empty())
+      return range;
+
+    ECS::AddComponents(range, transform);
+    auto &transforms = ECS::componentStorage<TransformComponent>();
+    for (std::size_t i = 0; i < range.Size(); ++i)
+      initFn(i, range[i], *transforms.Get(range[i]));
+
+    if (physics.has_value())
+      ECS::AddComponents(range, physics.value());
+    if (camera.has_value())
+      ECS::AddComponents(range, camera.value());
+    if (parent != NullEntity && ECS::HasEntity(parent))
+      ECS::AddComponents(range, HierarchyComponent{parent});
+    if (texturePath.has_value()) {
+      TextureComponent texture(texturePath.value());
+      texture.LoadTexture();
+      auto &entities = ECS::componentStorage<Entity>();
+      for (std::size_t i = 0; i < range.Size(); ++i)
+        entities.Get(range[i])->material = texture.textureID;
+      ECS::AddComponents(range, texture);
+    }
+
+    return range;
+  }
+
+  EntityRange BuildMany(std::uint32_t count) {
+    return BuildMany(count, [](std::size_t, EntityID, TransformComponent &) {});
+  }
+
+  // Resolves the builder into a reusable template instead of an entity: the
+  // mesh is resolved and the texture loaded here, once. The parent is not
+  // part of a prefab.
+  Prefab BuildPrefab() const {
+    Prefab prefab;
+    if (meshType.has_value())
+      prefab.mesh = MeshRegistry::Get(meshType.value(), meshParams);
+    prefab.tag = tag;
+    prefab.transform = transform;
+    prefab.physics = physics;
+    prefab.camera = camera;
+    if (texturePath.has_value()) {
+      TextureComponent texture(texturePath.value());
+      texture.LoadTexture();
+      prefab.texture = texture;
+    }
+    return prefab;
+  }
 };
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// An EntityID packs a slot index (low bits) and a generation (high bits).
+// Destroying an entity bumps the generation of its slot, so any handle still
+// holding the old generation no longer compares equal and is detected as stale.
+using EntityID = std::uint32_t;
+
+constexpr std::uint32_t EntityIndexBits = 22;
+constexpr std::uint32_t EntityGenerationBits = 32 - EntityIndexBits;
+constexpr std::uint32_t EntityIndexMask = (1u << EntityIndexBits) - 1;
+constexpr std::uint32_t EntityGenerationMask = (1u << EntityGenerationBits) - 1;
+
+// Never handed out; the all-ones index is reserved
+constexpr EntityID NullEntity = UINT32_MAX;
+
+constexpr std::uint32_t EntityIndex(EntityID id) { return id & EntityIndexMask; }
+constexpr std::uint32_t EntityGeneration(EntityID id) { return id >> EntityIndexBits; }
+
+constexpr EntityID MakeEntityID(std::uint32_t index, std::uint32_t generation) {
+    return ((generation & EntityGenerationMask) << EntityIndexBits) | (index & EntityIndexMask);
+}
+
+// A batch of entities created together. Fresh indices at generation 0 are
+// consecutive IDs, so the range is just the first ID and a count.
+struct EntityRange {
+    EntityID first = NullEntity;
+    std::uint32_t count = 0;
+
+    EntityID operator[](std::size_t i) const { return first + static_cast<EntityID>(i); }
+    std::size_t Size() const { return count; }
+    bool Empty() const { return count == 0; }
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "TransformSoA.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+// View frustum as six planes (normal.xyz, d) with normals pointing inward: a
+// point p is inside a plane when dot(normal, p) + d >= 0.
+struct Frustum {
+    glm::vec4 planes[6]; // left, right, bottom, top, near, far
+
+    // Planes of a clip-space matrix (projection * view), not normalized;
+    // the box test below does not need unit normals
+    static Frustum FromMatrix(const glm::mat4& viewProj);
+
+    // Conservative box test: false only if the box is fully outside a plane
+    bool Intersects(const glm::vec3& center, const glm::vec3& extent) const;
+};
+
+// World-space AABB of a local-space box under `model`: the center is
+// transformed, the half extents are rotated and scaled by |model's 3x3|
+void TransformBounds(const glm::mat4& model, const glm::vec3& localMin, const glm::vec3& localMax,
+                     glm::vec3& center, glm::vec3& extent);
+
+// World-space boxes as centers and half extents, one aligned array per
+// component, for batched culling
+class BoundsSoA {
+public:
+    void Clear();
+    void Reserve(std::size_t count);
+    void Push(const glm::vec3& center, const glm::vec3& extent);
+
+    std::size_t Size() const { return cx.size(); }
+
+    AlignedVector<float> cx, cy, cz; // center
+    AlignedVector<float> ex, ey, ez; // half extent
+};
+
+// Visible-versus-total counts of the last culled frame
+struct CullStats {
+    std::size_t total = 0;
+    std::size_t visible = 0;
+};
+
+// visible[i] = 1 if box i intersects the frustum, else 0. Tests 8 (AVX2) or
+// 4 (SSE2) boxes per iteration against all six planes. Returns how many are
+// visible.
+std::size_t CullBoxes(const Frustum& frustum, const BoundsSoA& boxes, std::uint8_t* visible);
+
+// The same with a given kernel (capped at ActiveSimdPath()), for comparing
+// paths in benchmarks and tests
+std::size_t CullBoxes(const Frustum& frustum, const BoundsSoA& boxes, std::uint8_t* visible, SimdPath path);
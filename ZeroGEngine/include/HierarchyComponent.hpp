@@ -0,0 +1,10 @@
+#pragma once
+
+#include "EntityID.hpp"
+
+// Parents an entity's transform to another entity's. The child's
+// TransformComponent is then relative to the parent's world transform.
+// A parent that is destroyed (or has no transform) leaves the child a root.
+struct HierarchyComponent {
+    EntityID parent = NullEntity;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed pool of worker threads fed from a shared FIFO queue.
+// A thread that waits on a JobCounter runs queued jobs while it waits, so
+// jobs may submit and wait on nested jobs without starving the pool.
+class JobSystem {
+public:
+    // Tracks completion of a group of submitted jobs
+    struct JobCounter {
+        std::atomic<int> pending{0};
+    };
+
+    // workerCount == 0 picks hardware_concurrency() - 1 (the caller is the extra thread)
+    explicit JobSystem(unsigned workerCount = 0);
+    ~JobSystem();
+
+    void Submit(std::function<void()> job, JobCounter& counter);
+    void Submit(std::function<void()> job); // fire and forget
+    void Wait(JobCounter& counter);
+
+    // Runs queued jobs on the calling thread until done() returns true; use
+    // this instead of blocking when the result depends on queued work
+    void HelpUntil(const std::function<bool()>& done);
+    bool RunOne(); // pops and runs one queued job; false if the queue was empty
+
+    // Splits [0, count) into chunks of at least `grain` items and runs
+    // fn(begin, end) across the pool; returns once every chunk is done
+    void ParallelFor(std::size_t count, std::size_t grain,
+                     const std::function<void(std::size_t, std::size_t)>& fn);
+
+    unsigned WorkerCount() const { return static_cast<unsigned>(workers.size()); }
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> queue;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    void WorkerLoop();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+};
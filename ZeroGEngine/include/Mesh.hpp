@@ -1,7 +1,17 @@
 #pragma once
 #include <vector>
 #include <glad/glad.h>
+#include <glm/glm.hpp>
 #include "MeshType.hpp"
+#include "Reflection.hpp"
+
+// Generation parameters; only the ones that apply to a mesh's type are used
+struct MeshParams {
+    int latBands = 16;  // Sphere
+    int longBands = 16; // Sphere
+};
+
+ZG_REFLECT(MeshParams, ZG_FIELD(latBands), ZG_FIELD(longBands));
 
 struct Mesh {
     MeshType type;
@@ -9,8 +19,9 @@ struct Mesh {
     std::vector<unsigned int> indices;
     unsigned int VAO{0}, VBO{0}, EBO{0};
     unsigned int indexCount{0};
+    glm::vec3 boundsMin{0.0f}, boundsMax{0.0f}; // local-space AABB of the vertices
 
-    Mesh(MeshType t);
+    Mesh(MeshType t, const MeshParams& params = MeshParams());
     Mesh(const Mesh&) = delete;
     Mesh(Mesh&&) noexcept;
     Mesh& operator=(Mesh&&) noexcept;
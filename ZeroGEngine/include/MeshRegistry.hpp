@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Mesh.hpp"
+
+#include <cstddef>
+#include <memory>
+
+// Shared meshes by (type, generation parameters). Entities that ask for the
+// same mesh get the same Mesh, so the geometry is built and uploaded once per
+// unique mesh instead of once per entity. The registry only keeps weak
+// references: a mesh is freed with the last entity or prefab that uses it
+// and rebuilt if it is asked for again. Thread-safe; meshes are created on
+// the calling thread, which must have the GL context.
+namespace MeshRegistry {
+
+    std::shared_ptr<Mesh> Get(MeshType type, const MeshParams& params = MeshParams());
+
+    // Meshes currently alive
+    std::size_t Count();
+
+}  // namespace MeshRegistry
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Mesh.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Plain 4-byte handle to a mesh in the MeshTable; 0 means "no mesh"
+using MeshHandle = std::uint32_t;
+constexpr MeshHandle NullMesh = 0;
+
+// Process-wide table of meshes. Entity records store a MeshHandle instead of
+// a shared_ptr; the owning World holds one table reference per live entity,
+// so copying or relocating entity records involves no refcount traffic.
+// Acquire/Retain/Release are thread-safe. Get() takes no lock and is valid
+// while the caller (or an entity it reads) holds a reference.
+namespace MeshTable {
+
+    // Registers a mesh (or finds it if already registered) and adds `refs`
+    // references. nullptr maps to NullMesh.
+    MeshHandle Acquire(std::shared_ptr<Mesh> mesh, std::uint32_t refs = 1);
+
+    void Retain(MeshHandle handle, std::uint32_t refs = 1);
+
+    // Retain() for a handle that may be stale or from another process;
+    // false (and nothing retained) if no mesh is registered under it
+    bool TryRetain(MeshHandle handle, std::uint32_t refs = 1);
+
+    // Drops a reference. Dropping the last one unregisters the mesh but only
+    // queues it for freeing, since worlds may be cleared on worker threads
+    // and GL objects must be deleted on the context thread.
+    void Release(MeshHandle handle);
+
+    // Frees meshes queued by Release(); call on the GL context thread
+    void CollectGarbage();
+
+    Mesh* Get(MeshHandle handle);
+
+    // Number of meshes currently registered
+    std::size_t Count();
+
+}  // namespace MeshTable
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "ComponentPool.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+class World;
+
+using ObserverID = std::uint32_t;
+
+// fn(world, entities): every entity that gained (or lost) the component since
+// the previous delivery, in the order it happened
+using ObserverFn = std::function<void(World&, const std::vector<EntityID>&)>;
+
+// Type-erased observer list, so the world can deliver every type's events
+class ObserverSetBase {
+public:
+    virtual ~ObserverSetBase() = default;
+
+    // Delivers pending events; returns false if there were none
+    virtual bool Dispatch(World& world) = 0;
+    virtual bool Remove(ObserverID id) = 0;
+};
+
+// Observers of one component type. Events are recorded by the pool and
+// delivered in batches, removals first, so an entity whose component was
+// removed and re-added is seen leaving before it comes back.
+template <typename T>
+class ObserverSet : public ObserverSetBase {
+public:
+    explicit ObserverSet(ComponentPool<T>& pool_) : pool(pool_) {}
+
+    void Add(ObserverID id, ObserverFn fn, bool onAdd) {
+        (onAdd ? added : removed).emplace_back(id, std::move(fn));
+        UpdateLogging();
+    }
+
+    bool Remove(ObserverID id) override {
+        bool found = Erase(added, id) || Erase(removed, id);
+        UpdateLogging();
+        return found;
+    }
+
+    bool Dispatch(World& world) override {
+        bool any = false;
+
+        if (!pool.RemovedLog().empty()) {
+            batch.swap(pool.RemovedLog());
+            Deliver(world, removed);
+            batch.clear();
+            any = true;
+        }
+
+        if (!pool.AddedLog().empty()) {
+            batch.swap(pool.AddedLog());
+
+            // Skip entities that lost the component again before delivery
+            batch.erase(std::remove_if(batch.begin(), batch.end(),
+                                       [this](EntityID id) { return !pool.Has(id); }),
+                        batch.end());
+            if (!batch.empty()) Deliver(world, added);
+            any = true;
+        }
+
+        batch.clear();
+        return any;
+    }
+
+private:
+    using Observers = std::vector<std::pair<ObserverID, ObserverFn>>;
+
+    ComponentPool<T>& pool;
+    Observers added;
+    Observers removed;
+    std::vector<EntityID> batch;
+
+    void Deliver(World& world, const Observers& observers) {
+        // Copy: callbacks may subscribe or unsubscribe while being called
+        Observers current = observers;
+        for (auto& observer : current) observer.second(world, batch);
+    }
+
+    void UpdateLogging() { pool.LogEvents(!added.empty(), !removed.empty()); }
+
+    static bool Erase(Observers& observers, ObserverID id) {
+        for (auto it = observers.begin(); it != observers.end(); ++it) {
+            if (it->first == id) {
+                observers.erase(it);
+                return true;
+            }
+        }
+        return false;
+    }
+};
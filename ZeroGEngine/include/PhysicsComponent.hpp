@@ -1,9 +1,9 @@
 #pragma once
 
 #include <glm/glm.hpp>
-#include <memory>
 #include <PxPhysicsAPI.h>
 #include "PhysicsOptions.hpp"
+#include <memory>
 
 struct PhysicsComponent {
     float mass{1.0f};
@@ -14,8 +14,9 @@ struct PhysicsComponent {
 
     physx::PxRigidActor* pxActor = nullptr;
 
-    // optional creation parameters (set by builder / scene loader)
-    std::shared_ptr<PhysicsOptions> options;
+    // optional creation parameters (set by builder / scene loader); an
+    // interned flyweight, see PhysicsOptions::Intern
+    std::shared_ptr<const PhysicsOptions> options;
 
     PhysicsComponent() = default;
     PhysicsComponent(float m, const glm::vec3& vel = glm::vec3(0.0f), const glm::vec3& acc = glm::vec3(0.0f))
@@ -1,5 +1,7 @@
 #pragma once
+#include "Reflection.hpp"
 #include <glm/glm.hpp>
+#include <memory>
 
 struct PhysicsOptions {
   enum class ShapeType { BOX, SPHERE, CAPSULE };
@@ -17,4 +19,20 @@ struct PhysicsOptions {
   float dynamicFriction = 0.5f;
   float restitution = 0.6f;
   bool isStatic = false;
+
+  bool operator==(const PhysicsOptions &other) const;
+
+  // Returns the shared, immutable copy of these options. Equal options map to
+  // the same object, so thousands of identical bodies share one instance. The
+  // table only keeps weak references: options are freed with the last
+  // component that uses them, so per-entity values don't pile up.
+  static std::shared_ptr<const PhysicsOptions> Intern(const PhysicsOptions &opts);
 };
+
+ZG_REFLECT_ENUM(PhysicsOptions::ShapeType, {PhysicsOptions::ShapeType::BOX, "box"},
+                {PhysicsOptions::ShapeType::SPHERE, "sphere"},
+                {PhysicsOptions::ShapeType::CAPSULE, "capsule"});
+
+ZG_REFLECT(PhysicsOptions, ZG_FIELD_AS(shapeType, "shape"), ZG_FIELD(dimensions),
+           ZG_FIELD(isKinematic), ZG_FIELD(mass), ZG_FIELD(staticFriction),
+           ZG_FIELD(dynamicFriction), ZG_FIELD(restitution), ZG_FIELD(isStatic));
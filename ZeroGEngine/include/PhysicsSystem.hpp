@@ -4,23 +4,29 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <PxPhysicsAPI.h>
+#include "ECS.hpp"
 #include "Entity.hpp"
+#include "JobSystem.hpp"
 #include "PhysicsComponent.hpp"
 #include "iostream"
 using namespace physx;
 
 class PhysicsSystem {
 public:
-    PhysicsSystem();
+    // Simulates the entities of one world (the calling thread's current world by default)
+    explicit PhysicsSystem(World& world = ECS::CurrentWorld());
     ~PhysicsSystem();
 
-    // Initialize PhysX; call once after creating object
-    void Init();
+    // Initialize PhysX; call once after creating object.
+    // With a job system, PhysX simulation tasks run on its workers.
+    void Init(JobSystem* jobs = nullptr);
 
     // Create a PhysX actor for the given entity/component (call when entity created)
     void CreatePhysXActor(Entity &entity, PhysicsComponent &physComp);
 
-    // Remove an actor and clean up (call when entity is destroyed)
+    // Remove an actor and clean up. Runs automatically when an entity loses
+    // its PhysicsComponent (or is destroyed); bodies added after Init() get
+    // their actor the same way.
     void RemoveActor(EntityID entityId);
 
     // Fixed-step update (call from your fixed-update loop)
@@ -49,26 +55,36 @@ public:
         return (it != entityToActor.end()) ? it->second : nullptr;
     }
 
+    World& GetWorld() const { return world; }
+
 private:
+    World& world;
+
     // PhysX core objects
     PxFoundation* foundation = nullptr;
     PxPhysics* physics = nullptr;
     PxCpuDispatcher* dispatcher = nullptr;
+    JobSystem* taskJobs = nullptr; // set when PhysX tasks run on the job system
     PxScene* scene = nullptr;
     PxMaterial* material = nullptr;
 
     // Fast entity-to-actor mapping
     std::unordered_map<EntityID, PxRigidActor*> entityToActor;
     
-    // Track only dynamic actors for efficient updates
-    std::vector<EntityID> dynamicEntities;
-    
-    // Set of entities marked for removal (processed at start of next update)
+    // Entities marked for removal (processed at event delivery or next update)
     std::unordered_set<EntityID> pendingRemovals;
 
+    // Steps since Init; paces the debug dump (per system, not per process)
+    int debugCounter = 0;
+
+    // PhysicsComponent lifecycle subscriptions
+    ObserverID addObserver = 0;
+    ObserverID removeObserver = 0;
+
     // Internal helper methods
     void ProcessPendingRemovals();
     void CleanupActor(EntityID entityId, PxRigidActor* actor);
+    void OnPhysicsAdded(const std::vector<EntityID>& added);
     
     // Prevent copying
     PhysicsSystem(const PhysicsSystem&) = delete;
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CameraComponent.hpp"
+#include "ECS.hpp"
+#include "PhysicsComponent.hpp"
+#include "TextureComponent.hpp"
+#include "TransformComponent.hpp"
+#include "World.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+// An entity template resolved once: the mesh is created, the physics options
+// interned and the texture loaded up front, and every instance shares them.
+// Instantiating is a batch create plus one bulk copy of each component into
+// its pool. Build one with EntityBuilder::BuildPrefab().
+struct Prefab {
+    std::shared_ptr<Mesh> mesh;
+    std::string tag;
+    TransformComponent transform;
+    std::optional<PhysicsComponent> physics;
+    std::optional<CameraComponent> camera;
+    std::optional<TextureComponent> texture; // already loaded
+
+    // Spawns `count` instances with consecutive IDs. initFn(i, id, transform)
+    // places each instance before the other components are attached.
+    template <typename InitFn>
+    EntityRange Instantiate(World& world, std::uint32_t count, InitFn&& initFn) const {
+        EntityRange range = world.CreateEntities(count, mesh, tag);
+        if (range.Empty()) return range;
+
+        world.AddMany(range, transform);
+        auto& transforms = world.Storage<TransformComponent>();
+        for (std::size_t i = 0; i < range.Size(); ++i) {
+            initFn(i, range[i], *transforms.Get(range[i]));
+        }
+
+        if (physics) world.AddMany(range, *physics);
+        if (camera) world.AddMany(range, *camera);
+        if (texture) {
+            auto& entities = world.Storage<Entity>();
+            for (std::size_t i = 0; i < range.Size(); ++i) {
+                entities.Get(range[i])->material = texture->textureID;
+            }
+            world.AddMany(range, *texture);
+        }
+        return range;
+    }
+
+    EntityRange Instantiate(World& world, std::uint32_t count = 1) const {
+        return Instantiate(world, count, [](std::size_t, EntityID, TransformComponent&) {});
+    }
+};
+
+// Prefabs by name, for code and scene files that spawn the same template
+// many times. Holds the prefabs' meshes, so clear it before the GL context
+// goes away.
+class PrefabLibrary {
+public:
+    // Adds or replaces a prefab
+    void Define(const std::string& name, Prefab prefab) { prefabs[name] = std::move(prefab); }
+
+    const Prefab* Find(const std::string& name) const {
+        auto found = prefabs.find(name);
+        return found != prefabs.end() ? &found->second : nullptr;
+    }
+
+    // Spawns `count` instances into the current world; an empty range (and a
+    // message) if there is no such prefab
+    template <typename InitFn>
+    EntityRange Spawn(const std::string& name, std::uint32_t count, InitFn&& initFn) const {
+        const Prefab* prefab = Find(name);
+        if (!prefab) {
+            std::cerr << "PrefabLibrary: no prefab named '" << name << "'\n";
+            return EntityRange();
+        }
+        return prefab->Instantiate(ECS::CurrentWorld(), count, std::forward<InitFn>(initFn));
+    }
+
+    EntityRange Spawn(const std::string& name, std::uint32_t count = 1) const {
+        return Spawn(name, count, [](std::size_t, EntityID, TransformComponent&) {});
+    }
+
+    std::size_t Size() const { return prefabs.size(); }
+    void Clear() { prefabs.clear(); }
+
+private:
+    std::unordered_map<std::string, Prefab> prefabs;
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Compile-time field lists for plain component structs. A struct is described
+// once, next to its definition:
+//
+//   ZG_REFLECT(TransformComponent, ZG_FIELD(position), ZG_FIELD(rotation), ZG_FIELD(scale));
+//
+// and the codecs (binary below, JSON in ReflectionJSON.hpp) are generated
+// from that list by the compiler: every field access is a member pointer
+// known at compile time, with no runtime type dispatch.
+
+// A named data member of T
+template <typename T, typename M>
+struct Field {
+    using Type = M;
+    const char* name;
+    M T::*member;
+};
+
+template <typename T, typename M>
+constexpr Field<T, M> MakeField(const char* name, M T::*member) {
+    return {name, member};
+}
+
+// Specialized by ZG_REFLECT; unreflected types are treated as leaf values
+template <typename T>
+struct Reflect {
+    static constexpr bool Reflected = false;
+};
+
+template <typename T>
+constexpr bool IsReflected = Reflect<T>::Reflected;
+
+// Value names for an enum, specialized by ZG_REFLECT_ENUM
+template <typename E>
+struct ReflectEnum {
+    static constexpr bool Reflected = false;
+};
+
+#define ZG_REFLECT(Type, ...)                                          \
+    template <>                                                        \
+    struct Reflect<Type> {                                             \
+        using Self = Type;                                             \
+        static constexpr bool Reflected = true;                        \
+        static constexpr auto Fields = std::make_tuple(__VA_ARGS__);   \
+    }
+
+// A field serialized under its member name, or under `key`
+#define ZG_FIELD(name) MakeField(#name, &Self::name)
+#define ZG_FIELD_AS(name, key) MakeField(key, &Self::name)
+
+// ZG_REFLECT_ENUM(Shape, {Shape::Box, "box"}, {Shape::Sphere, "sphere"});
+#define ZG_REFLECT_ENUM(Type, ...)                                          \
+    template <>                                                             \
+    struct ReflectEnum<Type> {                                              \
+        static constexpr bool Reflected = true;                             \
+        static constexpr std::pair<Type, const char*> Values[] = {__VA_ARGS__}; \
+    }
+
+// fn(field) for every field of T, in declaration order
+template <typename T, typename Fn>
+constexpr void ForEachField(Fn&& fn) {
+    std::apply([&](const auto&... field) { (fn(field), ...); }, Reflect<T>::Fields);
+}
+
+namespace Codec {
+
+    // Bytes WriteBinary() produces for a T: fields back to back, no padding
+    template <typename T>
+    constexpr std::size_t PackedSize() {
+        if constexpr (IsReflected<T>) {
+            std::size_t size = 0;
+            ForEachField<T>([&](const auto& field) {
+                size += PackedSize<typename std::decay_t<decltype(field)>::Type>();
+            });
+            return size;
+        } else {
+            static_assert(std::is_trivially_copyable<T>::value, "leaf values are copied as raw bytes");
+            return sizeof(T);
+        }
+    }
+
+    // Appends the packed fields of `value`
+    template <typename T>
+    void WriteBinary(std::vector<std::uint8_t>& out, const T& value) {
+        if constexpr (IsReflected<T>) {
+            ForEachField<T>([&](const auto& field) { WriteBinary(out, value.*field.member); });
+        } else {
+            static_assert(std::is_trivially_copyable<T>::value, "leaf values are copied as raw bytes");
+            const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+    }
+
+    // Reads fields written by WriteBinary() and advances `pos`; false if the
+    // data ends first
+    template <typename T>
+    bool ReadBinary(const std::uint8_t*& pos, const std::uint8_t* end, T& value) {
+        if constexpr (IsReflected<T>) {
+            if (static_cast<std::size_t>(end - pos) < PackedSize<T>()) return false;
+            ForEachField<T>([&](const auto& field) { ReadBinary(pos, end, value.*field.member); });
+            return true;
+        } else {
+            if (static_cast<std::size_t>(end - pos) < sizeof(T)) return false;
+            std::memcpy(&value, pos, sizeof(T));
+            pos += sizeof(T);
+            return true;
+        }
+    }
+
+}  // namespace Codec
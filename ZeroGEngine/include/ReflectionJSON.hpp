@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Reflection.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <iostream>
+#include <string>
+
+// JSON codec generated from ZG_REFLECT field lists. Structs map to objects
+// keyed by field name, glm vectors to arrays, reflected enums to their names.
+namespace Codec {
+
+    namespace detail {
+
+        template <typename V, int N>
+        nlohmann::json VecToJSON(const V& v) {
+            nlohmann::json array = nlohmann::json::array();
+            for (int i = 0; i < N; ++i) array.push_back(v[i]);
+            return array;
+        }
+
+        // Missing trailing components keep their current value, so [x, y]
+        // works for a vec3 with a default z
+        template <typename V, int N>
+        bool VecFromJSON(const nlohmann::json& j, V& v) {
+            if (!j.is_array()) return false;
+            for (int i = 0; i < N && i < static_cast<int>(j.size()); ++i) {
+                if (!j[i].is_number()) return false;
+                v[i] = j[i].template get<float>();
+            }
+            return true;
+        }
+
+        inline nlohmann::json ValueToJSON(const glm::vec2& v) { return VecToJSON<glm::vec2, 2>(v); }
+        inline nlohmann::json ValueToJSON(const glm::vec3& v) { return VecToJSON<glm::vec3, 3>(v); }
+        inline nlohmann::json ValueToJSON(const glm::vec4& v) { return VecToJSON<glm::vec4, 4>(v); }
+        inline bool ValueFromJSON(const nlohmann::json& j, glm::vec2& v) { return VecFromJSON<glm::vec2, 2>(j, v); }
+        inline bool ValueFromJSON(const nlohmann::json& j, glm::vec3& v) { return VecFromJSON<glm::vec3, 3>(j, v); }
+        inline bool ValueFromJSON(const nlohmann::json& j, glm::vec4& v) { return VecFromJSON<glm::vec4, 4>(j, v); }
+
+        template <typename T>
+        nlohmann::json ValueToJSON(const T& value) {
+            if constexpr (IsReflected<T>) {
+                nlohmann::json object = nlohmann::json::object();
+                ForEachField<T>([&](const auto& field) { object[field.name] = ValueToJSON(value.*field.member); });
+                return object;
+            } else if constexpr (std::is_enum<T>::value && ReflectEnum<T>::Reflected) {
+                for (const auto& entry : ReflectEnum<T>::Values) {
+                    if (entry.first == value) return entry.second;
+                }
+                return static_cast<std::underlying_type_t<T>>(value);
+            } else if constexpr (std::is_enum<T>::value) {
+                return static_cast<std::underlying_type_t<T>>(value);
+            } else {
+                static_assert(std::is_arithmetic<T>::value, "no JSON mapping for this field type");
+                return value;
+            }
+        }
+
+        template <typename T>
+        bool ValueFromJSON(const nlohmann::json& j, T& value) {
+            if constexpr (IsReflected<T>) {
+                if (!j.is_object()) return false;
+                bool ok = true;
+                ForEachField<T>([&](const auto& field) {
+                    auto found = j.find(field.name);
+                    if (found != j.end() && !ValueFromJSON(*found, value.*field.member)) {
+                        std::cerr << "Codec: field '" << field.name << "' has the wrong type\n";
+                        ok = false;
+                    }
+                });
+                return ok;
+            } else if constexpr (std::is_enum<T>::value) {
+                if constexpr (ReflectEnum<T>::Reflected) {
+                    if (j.is_string()) {
+                        const std::string& name = j.template get_ref<const std::string&>();
+                        for (const auto& entry : ReflectEnum<T>::Values) {
+                            if (name == entry.second) {
+                                value = entry.first;
+                                return true;
+                            }
+                        }
+                        return false;
+                    }
+                }
+                if (!j.is_number_integer()) return false;
+                value = static_cast<T>(j.template get<std::underlying_type_t<T>>());
+                return true;
+            } else if constexpr (std::is_same<T, bool>::value) {
+                if (!j.is_boolean()) return false;
+                value = j.template get<bool>();
+                return true;
+            } else {
+                static_assert(std::is_arithmetic<T>::value, "no JSON mapping for this field type");
+                if (!j.is_number()) return false;
+                value = j.template get<T>();
+                return true;
+            }
+        }
+
+    }  // namespace detail
+
+    template <typename T>
+    nlohmann::json ToJSON(const T& value) {
+        static_assert(IsReflected<T>, "ToJSON needs a ZG_REFLECT'ed type");
+        return detail::ValueToJSON(value);
+    }
+
+    // Overwrites the fields present in `j` and leaves the rest as they are, so
+    // defaults can be set on `value` first. Fields of the wrong type are
+    // reported and skipped; returns false if there were any.
+    template <typename T>
+    bool FromJSON(const nlohmann::json& j, T& value) {
+        static_assert(IsReflected<T>, "FromJSON needs a ZG_REFLECT'ed type");
+        return detail::ValueFromJSON(j, value);
+    }
+
+}  // namespace Codec
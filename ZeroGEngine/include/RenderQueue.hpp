@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CameraComponent.hpp"
+#include "Entity.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Draws in the order they are submitted in: translucent geometry after opaque
+enum class RenderPass : std::uint8_t { Opaque = 0, Transparent = 1 };
+
+// One draw call's worth of state. `model` and `camera` point at data that
+// must outlive the frame's Draw() (cached world matrices, camera components).
+struct DrawPacket {
+    std::uint64_t key;
+    const glm::mat4* model;
+    const CameraComponent* camera;
+    unsigned int program;
+    MaterialHandle material;
+    MeshHandle mesh;
+};
+
+// Per-frame counters filled in by RenderSystem::Draw()
+struct RenderStats {
+    std::size_t packets = 0;        // submitted
+    std::size_t drawCalls = 0;      // issued (packets without a drawable mesh are skipped)
+    std::size_t instances = 0;      // drawn, across all draw calls
+    std::size_t programBinds = 0;
+    std::size_t textureBinds = 0;
+    std::size_t vertexArrayBinds = 0;
+    std::size_t cameraUploads = 0;  // frame uniform buffer updates
+    std::size_t streamStalls = 0;   // waits for the GPU to release instance buffer space
+
+    std::size_t StateChanges() const { return programBinds + textureBinds + vertexArrayBinds + cameraUploads; }
+};
+
+// Draw packets for one frame, sorted by a packed 64-bit key so that packets
+// sharing a camera, then a program, then a texture, then a mesh end up next
+// to each other and the submit loop can skip the binds (and camera uploads)
+// that would not change anything:
+//
+//   63..62 pass | 61..58 camera | 57..50 program | 49..34 material | 33..18 mesh | 17..0 depth
+//
+// The camera field is the camera's slot in this frame's queue, in order of
+// first use. Opaque packets sort front to back within a state group,
+// transparent ones back to front. Only the low bits of the GL names and mesh
+// handles go into the key, and cameras past the last slot share it; a
+// collision costs an extra bind, never a wrong draw.
+class RenderQueue {
+public:
+    void Clear() {
+        packets.clear();
+        cameras.clear();
+    }
+
+    void Reserve(std::size_t count) { packets.reserve(count); }
+
+    // `depth` is the distance along the camera's view direction
+    void Push(RenderPass pass, unsigned int program, MaterialHandle material, MeshHandle mesh,
+              float depth, const glm::mat4* model, const CameraComponent* camera);
+
+    void Sort();
+
+    const std::vector<DrawPacket>& Packets() const { return packets; }
+    std::size_t Size() const { return packets.size(); }
+
+    static constexpr unsigned CameraSlots = 16;
+
+    static std::uint64_t MakeKey(RenderPass pass, unsigned cameraSlot, unsigned int program,
+                                 MaterialHandle material, MeshHandle mesh, float depth, float nearPlane,
+                                 float farPlane);
+
+private:
+    std::vector<DrawPacket> packets;
+    std::vector<const CameraComponent*> cameras; // by key slot, this frame
+
+    unsigned CameraSlot(const CameraComponent* camera);
+};
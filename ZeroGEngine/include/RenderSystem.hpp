@@ -6,30 +6,88 @@
 
 #include "TransformComponent.hpp"
 #include "CameraComponent.hpp"
+#include "RenderQueue.hpp"
+#include "StreamBuffer.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 // Forward declarations to reduce unnecessary includes
 class Entity;
 class CameraComponent;
 
+// Mirrors the std140 FrameData uniform block in the shaders
+struct FrameUniforms {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec4 viewPos;      // xyz
+    glm::vec4 lightPos;     // xyz
+    glm::vec4 lightColor;   // rgb
+    glm::vec4 ambientColor; // rgb
+};
+static_assert(sizeof(FrameUniforms) == 192, "FrameUniforms must match the std140 FrameData layout");
+
 struct RenderSystem {
     unsigned int shaderProgram{0};        // The shader program ID
-    int modelLoc, viewLoc, projLoc;  // Locations for transformation matrices
+    int modelLoc;  // Location of the per-draw model matrix
+    GLint textureLoc;
+    GLint instancedLoc;
+
+    // Binding point of the FrameData block in every program
+    static constexpr GLuint FrameBlockBinding = 0;
 
-    // Light-related uniform locations
-    GLuint lightPosLoc;
-    GLuint lightDirLoc;
-    GLuint lightColorLoc;
-    GLuint ambientColorLoc;
+    // Lighting for the frame, uploaded with the camera
+    glm::vec3 lightPos{10.0f, 10.0f, 10.0f};
+    glm::vec3 lightColor{1.0f, 1.0f, 1.0f};
+    glm::vec3 ambientColor{0.1f, 0.1f, 0.1f};
 
-    // Constructor and destructor for initializing and cleaning up resources
+    // Per-instance vertex attributes: model matrix columns, then normal matrix columns
+    static constexpr GLuint InstanceModelAttrib = 2;  // 2..5
+    static constexpr GLuint InstanceNormalAttrib = 6; // 6..8
+
+    // Counters for the last Draw()
+    RenderStats stats;
+
+    // Constructor and destructor for initializing and cleaning up GL
+    // resources; both need the context current
     RenderSystem();
     ~RenderSystem();
 
-    // Render an entity with its transform and the current camera
-    void RenderEntity(const Entity& e, const TransformComponent& t, const CameraComponent* cam);
+    // Uploads the camera and lights into the frame uniform buffer, which
+    // every program reads; call once per frame (and per camera) before
+    // RenderEntity(). Draw() does this itself.
+    void BeginFrame(const CameraComponent* cam);
+
+    // Render an entity with its world matrix and the camera of the last BeginFrame()
+    void RenderEntity(const Entity& e, const glm::mat4& model);
+
+    // Submits a sorted queue. Runs of packets that share program, camera,
+    // texture and mesh become one glDrawElementsInstanced call reading its
+    // model and normal matrices from the instance buffer; binds are only
+    // issued when the state differs from the previous draw's.
+    void Draw(const RenderQueue& queue);
 
 private:
+    struct InstanceData {
+        glm::mat4 model;
+        glm::vec3 normal[3]; // inverse transpose of the model's upper 3x3
+    };
+
+    struct Batch {
+        std::size_t packet;  // first packet of the run
+        std::uint32_t first; // first instance in this frame's allocation
+        std::uint32_t count;
+    };
+
+    unsigned int frameUBO{0};
+    StreamBuffer instanceStream{GL_ARRAY_BUFFER}; // this frame's instances, in draw order
+    std::vector<Batch> batches;
+
+    void BindInstanceAttributes(std::size_t base);
+    void DisableInstanceAttributes();
+    void BindFrameBlock(unsigned int program);
+
     // Private helper functions
     unsigned int compileShader(const char* vertexPath, const char* fragmentPath); // Compiles shaders from paths
     std::string readFile(const char* filepath);  // Reads file content for shader source
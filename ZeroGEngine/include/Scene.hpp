@@ -3,13 +3,45 @@
 
 
 #include "CameraComponent.hpp"
+#include "Frustum.hpp"
+#include "JobSystem.hpp"
+#include "RenderQueue.hpp"
+#include "TransformHierarchy.hpp"
+#include "World.hpp"
+#include <cstdint>
 #include <vector>
 
 
 struct Scene {
+    World& world;
+    TransformHierarchy hierarchy; // cached world matrices
     RenderSystem renderer;
+    RenderQueue queue;            // rebuilt every frame
     CameraComponent sceneCamera;
 
+    // Renders the entities of one world (the calling thread's current world by default)
+    explicit Scene(World& w);
     Scene();
-    void Render();
+    void Render(JobSystem* jobs = nullptr);
+
+    // Draw calls and state changes of the last Render()
+    const RenderStats& Stats() const { return renderer.stats; }
+
+    // Entities in view versus entities with a mesh, in the last Render()
+    const CullStats& Culling() const { return cullStats; }
+
+private:
+    // Entities drawn with the scene camera, culled together after gathering
+    struct Candidate {
+        const glm::mat4* model;
+        MaterialHandle material;
+        MeshHandle mesh;
+    };
+
+    std::vector<Candidate> candidates;
+    BoundsSoA bounds;
+    std::vector<std::uint8_t> visible;
+    CullStats cullStats;
+
+    void PushPacket(const Candidate& candidate, const CameraComponent& cam);
 };
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "ComponentType.hpp"
+#include "ECS.hpp"
+#include "JobSystem.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Runs registered systems once per frame.
+// Each system declares the component types it reads and writes. Two systems
+// conflict when one writes a type the other reads or writes; conflicting
+// systems run in registration order, everything else runs concurrently on
+// the job system. Structural changes (create/destroy, add/remove component)
+// made while systems run go through ECS::Commands() and are applied by
+// ECS::FlushCommands() after Run().
+//
+// Systems run against the world that is current when Run() is called. Reads()
+// and Writes() create the declared pools in the current world up front, since
+// pools are created lazily and that must not happen from concurrent systems.
+//
+//   scheduler.AddSystem("Physics", step).Writes<TransformComponent, PhysicsComponent>();
+//   scheduler.AddSystem("Render", draw).Reads<TransformComponent>().OnMainThread();
+class Scheduler {
+public:
+    using SystemFn = std::function<void(float)>;
+
+    class SystemBuilder {
+    public:
+        template <typename... Ts>
+        SystemBuilder& Reads() {
+            (ECS::CurrentWorld().Storage<Ts>(), ...);
+            (Declare(ECS::ComponentType<Ts>(), false), ...);
+            return *this;
+        }
+
+        template <typename... Ts>
+        SystemBuilder& Writes() {
+            (ECS::CurrentWorld().Storage<Ts>(), ...);
+            (Declare(ECS::ComponentType<Ts>(), true), ...);
+            return *this;
+        }
+
+        // Pin the system to the thread calling Run() (e.g. anything touching GL)
+        SystemBuilder& OnMainThread();
+
+    private:
+        friend class Scheduler;
+        SystemBuilder(Scheduler& s, std::size_t i) : scheduler(s), index(i) {}
+        void Declare(ComponentTypeID type, bool write);
+
+        Scheduler& scheduler;
+        std::size_t index;
+    };
+
+    explicit Scheduler(JobSystem& jobs);
+
+    SystemBuilder AddSystem(const std::string& name, SystemFn fn);
+
+    // Runs every system once; returns when all of them have finished
+    void Run(float dt);
+
+    // Systems grouped into stages that may run concurrently (for inspection)
+    const std::vector<std::vector<std::size_t>>& Stages();
+    void PrintStages(std::ostream& out);
+
+    JobSystem& Jobs() { return jobs; }
+
+private:
+    struct System {
+        std::string name;
+        SystemFn fn;
+        std::vector<ComponentTypeID> reads;
+        std::vector<ComponentTypeID> writes;
+        bool mainThread = false;
+    };
+
+    JobSystem& jobs;
+    std::vector<System> systems;
+    std::vector<std::vector<std::size_t>> stages;
+    bool stagesDirty = true;
+
+    static bool Conflicts(const System& a, const System& b);
+    void BuildStages();
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "TransformComponent.hpp"
+#include "World.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Maintenance pass that keeps dense pools in Morton (Z-order) order of
+// TransformComponent::position, so entities that are close in space are also
+// close in memory and spatial walks (culling, proximity queries, rendering
+// by region) touch fewer cache lines.
+//
+// The work is split across frames: Step() does at most `budget` units of
+// work (positions read, keys counted or scattered by a radix pass, or slots
+// swapped) and picks up where the previous call stopped. A pass snapshots
+// the entity order, computes Morton codes over the current bounds,
+// radix-sorts them, then moves each entity into place with SwapSlots(),
+// which keeps every entity -> component lookup valid. Entities added during a pass stay at the end until the next one.
+//
+// Step() rearranges pools, so call it at a sync point where no system is
+// iterating them (e.g. after FlushCommands()).
+class SpatialSort {
+public:
+    static constexpr std::size_t DefaultBudget = 16384;
+
+    explicit SpatialSort(World& world);
+
+    // Also keeps T's pool in the same entity order (Entity, PhysicsComponent...)
+    template <typename T>
+    SpatialSort& Follow() {
+        pools.push_back({&world.Storage<T>(), 0});
+        return *this;
+    }
+
+    void Step(std::size_t budget = DefaultBudget);
+
+    // Finishes the current pass (or runs a whole one) in a single call
+    void SortNow();
+
+    // Completed passes
+    std::size_t Passes() const { return passes; }
+
+    // 30-bit Morton code of a point quantized to 10 bits per axis
+    static std::uint32_t MortonCode(std::uint32_t x, std::uint32_t y, std::uint32_t z);
+
+private:
+    enum class Phase { Bounds, Keys, Count, Scatter, Apply };
+
+    struct SortedPool {
+        PoolBase* pool;
+        std::size_t placed; // slots [0, placed) already hold their entity
+    };
+
+    World& world;
+    std::vector<SortedPool> pools; // transforms first, then followers
+
+    Phase phase = Phase::Bounds;
+    std::size_t cursor = 0;
+    std::size_t passes = 0;
+    unsigned radixPass = 0;
+    glm::vec3 boundsMin{0.0f};
+    glm::vec3 boundsMax{0.0f};
+
+    std::vector<EntityID> order;     // entities of the pass; sorted order once applied
+    std::vector<std::uint64_t> keys; // Morton code << 32 | position in `order`
+    std::vector<std::uint64_t> scratch;
+    std::vector<EntityID> sorted;    // the last radix pass scatters into this
+    std::vector<std::size_t> counts; // radix bucket offsets of the current pass
+
+    void BeginPass();
+};
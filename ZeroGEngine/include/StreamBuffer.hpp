@@ -0,0 +1,74 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// Ring allocator for data rewritten every frame (instance matrices and the
+// like). With GL_ARB_buffer_storage the buffer is mapped once, persistently,
+// and split into Regions per-frame regions: a frame writes into one region
+// while the GPU may still be reading the previous ones, and a fence per
+// region tells when it can be reused. With three regions the CPU only waits
+// if it gets more than two frames ahead. On plain GL 3.3 the buffer is
+// orphaned and mapped again every frame instead.
+//
+//   stream.BeginFrame(bytes);          // picks (and if needed waits on) a region
+//   auto a = stream.Allocate(bytes);   // write through a.data ...
+//   stream.FinishWrites();             // ... then draw, sourcing from a.offset
+//   stream.EndFrame();                 // after the draws that read the region
+//
+// Create and destroy it with its GL context current.
+class StreamBuffer {
+public:
+    static constexpr unsigned Regions = 3;
+
+    struct Allocation {
+        void* data = nullptr;   // write-only; don't read it back
+        std::size_t offset = 0; // into Buffer()
+    };
+
+    explicit StreamBuffer(GLenum target, std::size_t regionSize = 1 << 20);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // Starts the next region, growing every region to at least `bytes`
+    // first (into a new buffer). Leaves Buffer() bound to the target. False
+    // if the buffer could not be mapped.
+    bool BeginFrame(std::size_t bytes = 0);
+
+    // `size` bytes of the current region, `alignment` aligned; data is
+    // nullptr when the region is full
+    Allocation Allocate(std::size_t size, std::size_t alignment = 16);
+
+    // Ends CPU writes for the frame; the region can be drawn from after this
+    void FinishWrites();
+
+    // Fences the region behind the commands issued so far
+    void EndFrame();
+
+    GLuint Buffer() const { return buffer; }
+    std::size_t RegionSize() const { return regionSize; }
+    bool Persistent() const { return persistent; }
+
+    // BeginFrame() calls that had to wait for the GPU, growth excluded
+    std::size_t Stalls() const { return stalls; }
+
+private:
+    GLenum target;
+    GLuint buffer{0};
+    bool persistent;
+    std::size_t regionSize;
+    std::size_t stalls = 0;
+
+    unsigned region = Regions - 1; // current region
+    std::size_t used = 0;          // bytes allocated in it
+    std::uint8_t* mapped = nullptr; // whole buffer (persistent) or current region
+    GLsync fences[Regions] = {};
+
+    void Create();
+    void Destroy();
+    bool WaitFence(unsigned index);
+};
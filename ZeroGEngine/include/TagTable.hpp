@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Interned tag name; 0 is the empty tag
+using TagID = std::uint32_t;
+constexpr TagID NoTag = 0;
+
+// Process-wide string table for entity tags. Each distinct name is stored
+// once and identified by a small integer, so entities carry a 4-byte TagID
+// and tag comparisons are integer compares. Thread-safe; interned names live
+// for the rest of the process.
+namespace TagTable {
+
+    // ID for `name`, interning it on first use
+    TagID Intern(std::string_view name);
+
+    // ID for `name` if it was ever interned, NoTag otherwise (never inserts)
+    TagID Find(std::string_view name);
+
+    const std::string& Name(TagID tag);
+
+}  // namespace TagTable
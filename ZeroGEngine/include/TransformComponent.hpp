@@ -1,9 +1,23 @@
-
 #pragma once
+#include "Reflection.hpp"
 #include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 
 struct TransformComponent {
     glm::vec3 position{0.0f,0.0f,0.0f};
     glm::vec3 rotation{0.0f,0.0f,0.0f};
     glm::vec3 scale{1.0f,1.0f,1.0f};
 };
+
+ZG_REFLECT(TransformComponent, ZG_FIELD(position), ZG_FIELD(rotation), ZG_FIELD(scale));
+
+// translate * rotateX * rotateY * rotateZ * scale (rotation in degrees)
+inline glm::mat4 LocalMatrix(const TransformComponent& t) {
+    glm::mat4 model(1.0f);
+    model = glm::translate(model, t.position);
+    model = glm::rotate(model, glm::radians(t.rotation.x), glm::vec3(1, 0, 0));
+    model = glm::rotate(model, glm::radians(t.rotation.y), glm::vec3(0, 1, 0));
+    model = glm::rotate(model, glm::radians(t.rotation.z), glm::vec3(0, 0, 1));
+    model = glm::scale(model, t.scale);
+    return model;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "HierarchyComponent.hpp"
+#include "JobSystem.hpp"
+#include "TransformComponent.hpp"
+#include "TransformSoA.hpp"
+#include "World.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Computes and caches world matrices for every entity with a
+// TransformComponent, following HierarchyComponent parents.
+//
+// Nodes are kept sorted by depth (roots first), so one linear sweep always
+// sees a parent before its children. A node is recomputed only when its own
+// transform changed since the last update or its parent was recomputed, so
+// static parts of the scene cost a tick compare per frame. Nodes of the same
+// depth are independent and are split across the job system when one is given.
+// Full recomputes (after a rebuild) compose the local matrices in SIMD batches
+// from an SoA copy of the transforms.
+// The node order is rebuilt when transforms or hierarchy links are added,
+// removed or modified.
+class TransformHierarchy {
+public:
+    explicit TransformHierarchy(World& world);
+
+    void Update(JobSystem* jobs = nullptr);
+
+    // Cached world matrix from the last Update(), or nullptr
+    const glm::mat4* WorldMatrix(EntityID id) const {
+        std::uint32_t index = EntityIndex(id);
+        if (index >= nodeOf.size() || nodeOf[index] == NoNode) return nullptr;
+        std::uint32_t node = nodeOf[index];
+        return ids[node] == id ? &worldMatrices[node] : nullptr;
+    }
+
+    std::size_t NodeCount() const { return ids.size(); }
+    std::size_t Depth() const { return levelStarts.empty() ? 0 : levelStarts.size() - 1; }
+
+    // Nodes recomputed by the last Update()
+    std::size_t LastUpdatedCount() const { return lastUpdated; }
+
+private:
+    static constexpr std::uint32_t NoNode = UINT32_MAX;
+    static constexpr std::size_t ParallelGrain = 1024;
+
+    World& world;
+
+    // Node arrays, index-aligned and sorted by depth
+    std::vector<EntityID> ids;
+    std::vector<std::uint32_t> parents; // node index of the parent, or NoNode
+    AlignedVector<glm::mat4> worldMatrices;
+    std::vector<std::uint8_t> dirty;
+
+    std::vector<std::size_t> levelStarts; // nodes of depth d: [levelStarts[d], levelStarts[d + 1])
+    std::vector<std::uint32_t> nodeOf;    // by entity index
+    TransformSoA soa;                     // scratch for full recomputes
+
+    std::uint32_t lastTick = 0;
+    std::size_t transformCount = 0;
+    std::size_t hierarchyCount = 0;
+    bool built = false;
+    std::size_t lastUpdated = 0;
+
+    bool StructureChanged() const;
+    void Rebuild();
+    void ComposeLocals(const ComponentPool<TransformComponent>& transforms, JobSystem* jobs);
+    std::size_t UpdateRange(const ComponentPool<TransformComponent>& transforms, std::size_t begin, std::size_t end, bool all);
+};
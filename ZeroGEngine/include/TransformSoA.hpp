@@ -0,0 +1,77 @@
+#pragma once
+
+#include "ComponentPool.hpp"
+#include "TransformComponent.hpp"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// Minimal allocator for SIMD-aligned vectors
+template <typename T, std::size_t Align = 32>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Align>; };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align)));
+    }
+    void deallocate(T* p, std::size_t) { ::operator delete(p, std::align_val_t(Align)); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Align>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Align>&) const { return false; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// Structure-of-arrays copy of a set of transforms: one aligned float array per
+// field, padded to a multiple of Lanes with identity transforms so the batch
+// kernel never needs a tail loop.
+class TransformSoA {
+public:
+    static constexpr std::size_t Lanes = 8;
+
+    // Every transform in the pool, in dense order
+    void Gather(const ComponentPool<TransformComponent>& pool);
+
+    // The transforms of `ids`, in that order (missing ones become identity)
+    void Gather(const ComponentPool<TransformComponent>& pool, const std::vector<EntityID>& ids);
+
+    void Resize(std::size_t count);
+    void Set(std::size_t i, const TransformComponent& t);
+
+    std::size_t Size() const { return count; }
+    std::size_t PaddedSize() const { return px.size(); }
+
+    AlignedVector<float> px, py, pz; // position
+    AlignedVector<float> rx, ry, rz; // Euler rotation, degrees
+    AlignedVector<float> sx, sy, sz; // scale
+
+private:
+    std::size_t count = 0;
+};
+
+enum class SimdPath { Scalar, SSE2, AVX2 };
+
+// The widest kernel this CPU can run (picked once, at first use)
+SimdPath ActiveSimdPath();
+const char* SimdPathName(SimdPath path);
+
+// Writes model matrices (the same translate * rotX * rotY * rotZ * scale as
+// LocalMatrix()) for transforms [begin, end) to out[begin, end), 8 (AVX2) or
+// 4 (SSE2) at a time. A 32-byte aligned `out` and a `begin` that is a
+// multiple of TransformSoA::Lanes give the fastest stores.
+void ComposeModelMatrices(const TransformSoA& soa, glm::mat4* out, std::size_t begin, std::size_t end);
+
+inline void ComposeModelMatrices(const TransformSoA& soa, glm::mat4* out) {
+    ComposeModelMatrices(soa, out, 0, soa.Size());
+}
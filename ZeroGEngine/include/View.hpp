@@ -0,0 +1,152 @@
+#pragma once
+
+#include "ECS.hpp"
+#include "JobSystem.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace ECS {
+
+    // Iterates the entities of a world (the current one by default) that own
+    // every component in Ts.
+    // Candidates come from the smallest pool; the remaining pools are probed
+    // with O(1) sparse lookups. Iteration runs back to front, so destroying the
+    // current entity (or removing one of its components) inside the loop is safe.
+    //
+    //   ECS::View<TransformComponent, PhysicsComponent> view;
+    //   view.Each([](EntityID id, TransformComponent& t, PhysicsComponent& p) { ... });
+    //
+    // Mutable Ts are fetched with Get() and stamped as changed; list a type as
+    // const to read it without touching its change tick. Changed<T>(since) and
+    // Added<T>(since) narrow the view to components stamped at or after `since`.
+    // A system that wants only what happened since it last ran keeps the tick
+    // it last ran at:
+    //
+    //   view.Changed<TransformComponent>(lastRun).Each(...);
+    //   lastRun = world.CurrentTick();
+    template <typename... Ts>
+    class View {
+        static_assert(sizeof...(Ts) > 0, "View needs at least one component type");
+
+        template <typename T>
+        using PoolOf = ComponentPool<std::remove_const_t<T>>;
+
+    public:
+        View() : View(CurrentWorld()) {}
+
+        explicit View(World& world_) : world(&world_), pools(&world_.Storage<std::remove_const_t<Ts>>()...) {
+            std::size_t smallest = SIZE_MAX;
+            ((Consider(std::get<PoolOf<Ts>*>(pools)->Entities(), smallest)), ...);
+        }
+
+        // Only components of type T last changed at or after `since`
+        template <typename T>
+        View& Changed(std::uint32_t since) {
+            filters.push_back({&world->Storage<std::remove_const_t<T>>(), &ChangedTickOf<std::remove_const_t<T>>, since});
+            return *this;
+        }
+
+        // Only components of type T added at or after `since`
+        template <typename T>
+        View& Added(std::uint32_t since) {
+            filters.push_back({&world->Storage<std::remove_const_t<T>>(), &AddedTickOf<std::remove_const_t<T>>, since});
+            return *this;
+        }
+
+        // fn(EntityID, Ts&...)
+        template <typename Func>
+        void Each(Func&& fn) {
+            for (std::size_t i = candidates->size(); i-- > 0;) {
+                if (i >= candidates->size()) continue;
+                EntityID id = (*candidates)[i];
+                if (Contains(id)) fn(id, *Fetch<Ts>(id)...);
+            }
+        }
+
+        // Runs fn(EntityID, Ts&...) over the matches in parallel chunks, with
+        // the view's world current on every worker. fn may only write the
+        // components it is handed; record structural changes
+        // (create/destroy/add/remove) with ECS::Commands() instead.
+        template <typename Func>
+        void ParallelEach(JobSystem& jobs, Func&& fn, std::size_t grain = 1024) {
+            std::vector<EntityID> matches = Entities();
+            jobs.ParallelFor(matches.size(), grain, [&](std::size_t begin, std::size_t end) {
+                WorldScope scope(*world);
+                for (std::size_t i = begin; i < end; ++i) {
+                    EntityID id = matches[i];
+                    fn(id, *Fetch<Ts>(id)...);
+                }
+            });
+        }
+
+        bool Contains(EntityID id) const {
+            if (!(std::get<PoolOf<Ts>*>(pools)->Has(id) && ...)) return false;
+            for (const TickFilter& filter : filters) {
+                if (!TickAtOrAfter(filter.tickOf(filter.pool, id), filter.since)) return false;
+            }
+            return true;
+        }
+
+        template <typename T>
+        T& Get(EntityID id) {
+            return *Fetch<T>(id);
+        }
+
+        // Upper bound on the number of matches (size of the driving pool)
+        std::size_t SizeHint() const { return candidates->size(); }
+
+        // Matching entities, collected up front (for range-for and job splitting)
+        std::vector<EntityID> Entities() const {
+            std::vector<EntityID> out;
+            out.reserve(candidates->size());
+            for (EntityID id : *candidates) {
+                if (Contains(id)) out.push_back(id);
+            }
+            return out;
+        }
+
+    private:
+        struct TickFilter {
+            const PoolBase* pool;
+            std::uint32_t (*tickOf)(const PoolBase*, EntityID);
+            std::uint32_t since;
+        };
+
+        World* world;
+        std::tuple<PoolOf<Ts>*...> pools;
+        const std::vector<EntityID>* candidates = nullptr;
+        std::vector<TickFilter> filters;
+
+        template <typename T>
+        T* Fetch(EntityID id) {
+            auto* pool = std::get<PoolOf<T>*>(pools);
+            if constexpr (std::is_const_v<T>) {
+                return pool->Read(id);
+            } else {
+                return pool->Get(id);
+            }
+        }
+
+        template <typename T>
+        static std::uint32_t ChangedTickOf(const PoolBase* pool, EntityID id) {
+            return static_cast<const ComponentPool<T>*>(pool)->ChangedTick(id);
+        }
+
+        template <typename T>
+        static std::uint32_t AddedTickOf(const PoolBase* pool, EntityID id) {
+            return static_cast<const ComponentPool<T>*>(pool)->AddedTick(id);
+        }
+
+        void Consider(const std::vector<EntityID>& entities, std::size_t& smallest) {
+            if (entities.size() < smallest) {
+                smallest = entities.size();
+                candidates = &entities;
+            }
+        }
+    };
+
+}  // namespace ECS
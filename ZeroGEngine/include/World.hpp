@@ -0,0 +1,225 @@
+#pragma once
+
+#include "ComponentPool.hpp"
+#include "ComponentType.hpp"
+#include "Entity.hpp"
+#include "Observers.hpp"
+#include "TagTable.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class CommandBuffer;
+
+// One self-contained ECS: entity slot table, component pools and command
+// buffers. Worlds share nothing, so independent worlds can be stepped on
+// different threads at the same time.
+//
+// Pools are created on first use. Create them (touch Storage<T>()) from the
+// thread that owns the world before handing it to workers.
+class World {
+public:
+    World();
+    ~World();
+
+    // Entity management
+    EntityID CreateEntity(std::shared_ptr<Mesh> mesh = nullptr, const std::string& tag = "");
+
+    // Creates `count` entities with consecutive IDs, all sharing the same mesh
+    // and tag. Indices come from fresh space (the free list is skipped) and
+    // storage grows once. Returns an empty range if the index space runs out.
+    EntityRange CreateEntities(std::uint32_t count, std::shared_ptr<Mesh> mesh = nullptr, const std::string& tag = "");
+
+    // Claims a fresh ID without creating the entity; safe from any thread.
+    // The entity becomes live once CreateReservedEntity() runs on the owning thread.
+    EntityID ReserveEntity();
+    bool CreateReservedEntity(EntityID id, std::shared_ptr<Mesh> mesh = nullptr, const std::string& tag = "");
+    bool CreateReservedEntity(EntityID id, std::shared_ptr<Mesh> mesh, TagID tag);
+
+    // Claims `count` consecutive fresh indices with one atomic operation, for a
+    // thread to hand out as IDs (at generation 0) without further
+    // synchronization. Returns the first index, or EntityIndexMask when they
+    // don't fit. Safe from any thread.
+    std::uint32_t ReserveIndices(std::uint32_t count) { return ClaimFreshRange(count); }
+
+    // Returns reserved indices that were never created to the free list
+    // (owning thread)
+    void ReleaseReservedIndices(std::uint32_t first, std::uint32_t count);
+
+    bool HasEntity(EntityID id) const {
+        std::uint32_t index = EntityIndex(id);
+        return index < slots.size() && slots[index] == id;
+    }
+    Entity* GetEntity(EntityID id) { return Storage<Entity>().Get(id); }
+    void DestroyEntity(EntityID id);
+
+    // Tags are interned (see TagTable) and kept in a side table by entity
+    // index, plus a tag -> entities index for O(matches) lookups
+    TagID GetTagID(EntityID id) const { return HasEntity(id) ? tags[EntityIndex(id)] : NoTag; }
+    const std::string& GetTag(EntityID id) const { return TagTable::Name(GetTagID(id)); }
+    void SetTag(EntityID id, TagID tag);
+    void SetTag(EntityID id, std::string_view tag) { SetTag(id, TagTable::Intern(tag)); }
+
+    // Live entities with the tag, in no particular order. The reference is
+    // invalidated by creating, destroying or retagging entities.
+    const std::vector<EntityID>& FindByTag(TagID tag) const;
+    const std::vector<EntityID>& FindByTag(std::string_view tag) const { return FindByTag(TagTable::Find(tag)); }
+
+    // fn(EntityID) for each entity with the tag. Runs back to front, so fn
+    // may destroy or retag the entity it is given.
+    template <typename Func>
+    void ForEachWithTag(TagID tag, Func&& fn) {
+        if (tag == NoTag) return;
+        for (std::size_t i = tag < tagged.size() ? tagged[tag].size() : 0; i-- > 0;) {
+            if (i >= tagged[tag].size()) continue;
+            fn(tagged[tag][i]);
+        }
+    }
+
+    template <typename Func>
+    void ForEachWithTag(std::string_view tag, Func&& fn) { ForEachWithTag(TagTable::Find(tag), std::forward<Func>(fn)); }
+    void Clear();
+    std::size_t EntityCount() { return Storage<Entity>().Size(); }
+
+    // Bytes held by the entity tables and every pool
+    std::size_t MemoryUsage() const;
+
+    // Returns spare capacity (pools, entity tables, tag lists) to the allocator;
+    // worth calling after a level unload in long sessions
+    void ShrinkToFit();
+
+    // Component management
+    template <typename T>
+    ComponentPool<T>& Storage() {
+        ComponentTypeID type = ECS::ComponentType<T>();
+        if (type >= pools.size()) pools.resize(type + 1);
+        if (!pools[type]) {
+            auto pool = std::make_unique<ComponentPool<T>>();
+            pool->SetTickSource(&tick);
+            pool->SetMaskSource(&masks, ComponentBit(type));
+            pools[type] = std::move(pool);
+        }
+        return static_cast<ComponentPool<T>&>(*pools[type]);
+    }
+
+    // Mutable access; stamps the component as changed at the current tick
+    template <typename T>
+    T* Get(EntityID id) { return Storage<T>().Get(id); }
+
+    // Read-only access; leaves the change tick alone
+    template <typename T>
+    const T* Read(EntityID id) { return Storage<T>().Read(id); }
+
+    template <typename T>
+    bool Has(EntityID id) { return Storage<T>().Has(id); }
+
+    // Bits (ComponentBit(type)) of the component types the entity has; types
+    // past MaskedTypes don't appear
+    ComponentMask GetComponentMask(EntityID id) const { return HasEntity(id) ? masks[EntityIndex(id)] : 0; }
+
+    // Ignored for dead or stale handles
+    template <typename T>
+    void Add(EntityID id, T&& component) {
+        if (HasEntity(id)) {
+            Storage<std::decay_t<T>>().Insert(id, std::forward<T>(component));
+        }
+    }
+
+    // Gives every entity of a batch a copy of `component`, growing the pool once
+    template <typename T>
+    void AddMany(const EntityRange& range, const T& component) {
+        auto& pool = Storage<T>();
+        pool.Reserve(pool.Size() + range.Size());
+        for (std::size_t i = 0; i < range.Size(); ++i) {
+            if (HasEntity(range[i])) pool.Emplace(range[i], component);
+        }
+    }
+
+    template <typename T>
+    void Remove(EntityID id) { Storage<T>().Erase(id); }
+
+    // Lifecycle observers. fn(world, entities) gets every entity that gained
+    // (OnAdd) or lost (OnRemove, including by destruction or Clear) a T since
+    // the last delivery. Delivery is deferred to DispatchEvents(), which
+    // FlushCommands() also runs; events raised by observers are delivered in
+    // the same call.
+    template <typename T>
+    ObserverID OnAdd(ObserverFn fn) { return Observe<T>(std::move(fn), true); }
+
+    template <typename T>
+    ObserverID OnRemove(ObserverFn fn) { return Observe<T>(std::move(fn), false); }
+
+    void RemoveObserver(ObserverID id);
+    void DispatchEvents();
+
+    // Change-tracking clock. Component slots are stamped with the tick they
+    // were added / last written at. Advance once per frame (or step).
+    std::uint32_t CurrentTick() const { return tick; }
+    std::uint32_t AdvanceTick() { return ++tick; }
+
+    // Deferred structural changes: the calling thread's buffer for this world,
+    // and playback of every thread's buffer (owning thread, at a sync point)
+    CommandBuffer& Commands();
+    void FlushCommands();
+
+private:
+    friend class WorldSnapshot;
+
+    // slots[index] holds the live handle for that index, or NullEntity while
+    // the index is free or only reserved; generations[index] is the
+    // generation the next occupant will get. Fresh indices come from an
+    // atomic counter so ReserveEntity() can run on any thread.
+    std::vector<EntityID> slots;
+    std::vector<std::uint32_t> generations;
+    std::vector<std::uint32_t> freeList;
+    std::atomic<std::uint32_t> nextIndex{0};
+    std::vector<TagID> tags;                 // by entity index
+    std::vector<std::uint32_t> tagSlots;     // position in tagged[tag], by entity index
+    std::vector<std::vector<EntityID>> tagged; // by TagID
+    std::vector<ComponentMask> masks;        // by entity index, kept by the pools
+
+    std::vector<std::unique_ptr<PoolBase>> pools; // indexed by ComponentTypeID
+    std::uint32_t tick = 1; // 0 is reserved for "never"
+
+    std::vector<std::unique_ptr<ObserverSetBase>> observers; // indexed by ComponentTypeID
+    ObserverID nextObserver = 1;
+    bool dispatching = false;
+
+    // Buffers are shared with the recording thread, so commands from a thread
+    // that has since exited still get played back
+    std::uint64_t serial;
+    std::mutex bufferMutex;
+    std::vector<std::shared_ptr<CommandBuffer>> buffers;
+
+    // For WorldSnapshot::Restore: whether any buffer holds unplayed commands,
+    // and handing every buffer's unused ID block back (owning thread)
+    bool HasPendingCommands();
+    void ReleaseCommandIDs();
+
+    template <typename T>
+    ObserverID Observe(ObserverFn fn, bool onAdd) {
+        ComponentTypeID type = ECS::ComponentType<T>();
+        if (type >= observers.size()) observers.resize(type + 1);
+        if (!observers[type]) observers[type] = std::make_unique<ObserverSet<T>>(Storage<T>());
+
+        ObserverID id = nextObserver++;
+        static_cast<ObserverSet<T>&>(*observers[type]).Add(id, std::move(fn), onAdd);
+        return id;
+    }
+
+    std::uint32_t ClaimFreshIndex();
+    std::uint32_t ClaimFreshRange(std::uint32_t count);
+    void EnsureSlot(std::uint32_t index);
+    void Untag(std::uint32_t index);
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+};
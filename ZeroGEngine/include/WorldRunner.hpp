@@ -0,0 +1,44 @@
+#pragma once
+
+#include "JobSystem.hpp"
+#include "World.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+// Steps many independent worlds in parallel (parameter sweeps, training
+// rollouts). Each world is stepped by a single job at a time with the job's
+// thread bound to that world, so code using the ECS free functions inside
+// the step function sees the right world. Commands recorded during a step
+// are flushed after it.
+class WorldRunner {
+public:
+    // step(world, worldIndex, dt); called once per world per step
+    using StepFn = std::function<void(World&, std::size_t, float)>;
+
+    struct Report {
+        std::size_t worlds = 0;
+        std::size_t stepsPerWorld = 0;
+        double seconds = 0.0;
+        double worldStepsPerSecond = 0.0;
+    };
+
+    WorldRunner(JobSystem& jobs, StepFn step);
+
+    World& AddWorld();
+    World& GetWorld(std::size_t index) { return *worlds[index]; }
+    std::size_t WorldCount() const { return worlds.size(); }
+
+    // Advances every world by `steps` fixed steps; returns once all are done
+    Report Run(std::size_t steps, float dt);
+
+    static void PrintReport(const Report& report, std::ostream& out);
+
+private:
+    JobSystem& jobs;
+    StepFn step;
+    std::vector<std::unique_ptr<World>> worlds;
+};
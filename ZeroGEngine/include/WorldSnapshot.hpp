@@ -0,0 +1,113 @@
+#pragma once
+
+#include "ComponentType.hpp"
+#include "World.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Binary checkpoint of a whole world: the entity table, tags and every
+// registered component pool.
+//
+// Layout (host byte order): a header (magic, version, counts), the entity
+// slot table, the names of the tags in use, then one section per pool with a
+// small schema (name, element size, count) followed by the pool's dense
+// entity and component arrays as raw bytes. Capture and restore are a memcpy
+// per array; restoring rebuilds each pool's sparse index in one pass instead
+// of inserting entity by entity. Restored components count as added at the
+// world's current tick, so change-tracking systems pick all of them up.
+//
+// Only trivially copyable components without pointers can be registered
+// (Entity, transforms, hierarchy links and cameras are by default). Pools the
+// snapshot doesn't mention are left empty on restore; sections for types not
+// registered in this process, or whose size changed, are skipped.
+//
+// Mesh and material handles are process-local, so a snapshot is restored
+// with its meshes only in the process that took it (crash recovery, A/B
+// replay); elsewhere entities come back without meshes.
+//
+// Restore replaces the world's index space, so it refuses to run while any
+// command buffer holds recorded commands: call ECS::FlushCommands() first, at
+// the same kind of sync point. Buffers' unused ID blocks are dropped, and
+// IDs taken with ReserveEntity() but not yet created are no longer valid.
+//
+// A snapshot is immutable once captured and cheap to copy. Capture() runs on
+// the thread that owns the world; WriteFileAsync() then writes the frozen
+// copy from a background thread while the world keeps running.
+class WorldSnapshot {
+public:
+    static constexpr std::uint32_t Version = 1;
+
+    // Adds T to the pools every snapshot contains. `name` identifies the
+    // section in the file and must be stable across builds.
+    template <typename T>
+    static void Register(const std::string& name) {
+        RegisterType(MakeTypeInfo<T>(name));
+    }
+
+    WorldSnapshot() = default;
+
+    static WorldSnapshot Capture(World& world);
+
+    // Replaces the world's contents with the snapshot's. Returns false, with
+    // the world untouched, if the data is malformed or from another version,
+    // or if commands are still waiting to be flushed.
+    bool Restore(World& world) const;
+
+    bool WriteFile(const std::string& path) const;
+    std::future<bool> WriteFileAsync(const std::string& path) const;
+
+    // Empty snapshot if the file can't be read
+    static WorldSnapshot ReadFile(const std::string& path);
+
+    bool Empty() const { return !data || data->empty(); }
+    std::size_t ByteSize() const { return data ? data->size() : 0; }
+    const std::uint8_t* Bytes() const { return data ? data->data() : nullptr; }
+
+private:
+    using Buffer = std::vector<std::uint8_t>;
+
+    struct TypeInfo {
+        std::string name;
+        ComponentTypeID type;
+        std::size_t size;
+        void (*save)(World&, Buffer&);
+        void (*load)(World&, const std::uint8_t* ids, const std::uint8_t* values, std::uint32_t count);
+    };
+
+    std::shared_ptr<const Buffer> data;
+
+    explicit WorldSnapshot(std::shared_ptr<const Buffer> data_) : data(std::move(data_)) {}
+
+    template <typename T>
+    static TypeInfo MakeTypeInfo(const std::string& name) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot sections are raw copies");
+        return {name, ECS::ComponentType<T>(), sizeof(T), &SavePool<T>, &LoadPool<T>};
+    }
+
+    // Registered types; the built-in ones are there from the start
+    static std::vector<TypeInfo>& TypeList();
+    static void RegisterType(TypeInfo info);
+    static std::vector<TypeInfo> RegisteredTypes();
+
+    static void Put(Buffer& out, const void* bytes, std::size_t size);
+
+    template <typename T>
+    static void SavePool(World& world, Buffer& out) {
+        const auto& pool = world.Storage<T>();
+        std::uint32_t count = static_cast<std::uint32_t>(pool.Size());
+        Put(out, &count, sizeof(count));
+        Put(out, pool.Entities().data(), count * sizeof(EntityID));
+        Put(out, pool.Components().data(), count * sizeof(T));
+    }
+
+    template <typename T>
+    static void LoadPool(World& world, const std::uint8_t* ids, const std::uint8_t* values, std::uint32_t count) {
+        world.Storage<T>().Assign(ids, values, count);
+    }
+};
@@ -3,29 +3,34 @@ in vec3 FragPos;
 in vec3 Normal;   
 out vec4 FragColor;
 
-uniform vec3 lightPos;
-uniform vec3 lightColor;
-uniform vec3 ambientColor;
-uniform vec3 viewPos;
+// Per-frame camera and lights, shared by every program (std140, binding 0)
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+    vec4 lightPos;
+    vec4 lightColor;
+    vec4 ambientColor;
+};
 uniform sampler2D texture1; // Texture sampler
 
 void main()
 {
     vec3 norm = normalize(Normal);
-    vec3 lightDir = normalize(lightPos - FragPos);
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 lightDir = normalize(lightPos.xyz - FragPos);
+    vec3 viewDir = normalize(viewPos.xyz - FragPos);
 
     // Ambient
-    vec3 ambient = 0.1 * lightColor;
+    vec3 ambient = 0.1 * lightColor.rgb;
 
     // Diffuse
     float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * lightColor;
+    vec3 diffuse = diff * lightColor.rgb;
 
     // Specular
     vec3 reflectDir = reflect(-lightDir, norm);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
-    vec3 specular = 0.5 * spec * lightColor;
+    vec3 specular = 0.5 * spec * lightColor.rgb;
 
     // Apply texture
     vec4 texColor = texture(texture1, FragPos.xy); // Sample the texture
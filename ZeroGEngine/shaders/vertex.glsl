@@ -1,16 +1,30 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
+// Per-instance, when drawn through RenderSystem::Draw()
+layout (location = 2) in mat4 instanceModel;  // 2..5
+layout (location = 6) in mat3 instanceNormal; // 6..8
 out vec3 FragPos; // For fragment shader
 out vec3 Normal;  // For fragment shader
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// Per-frame camera and lights, shared by every program (std140, binding 0)
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+    vec4 lightPos;
+    vec4 lightColor;
+    vec4 ambientColor;
+};
+uniform bool instanced;
 
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0)); // World position of the vertex
-    Normal = mat3(transpose(inverse(model))) * aNormal; // Transformed normal
+    mat4 world = instanced ? instanceModel : model;
+    mat3 normalMatrix = instanced ? instanceNormal : mat3(transpose(inverse(model)));
+
+    FragPos = vec3(world * vec4(aPos, 1.0)); // World position of the vertex
+    Normal = normalMatrix * aNormal; // Transformed normal
 
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
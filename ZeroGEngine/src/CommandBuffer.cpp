@@ -0,0 +1,83 @@
+#include "CommandBuffer.hpp"
+#include "ECS.hpp"
+
+EntityID CommandBuffer::CreateEntity(std::shared_ptr<Mesh> mesh, const std::string& tag) {
+    EntityID id;
+    if (blockNext == blockEnd) {
+        std::uint32_t first = world.ReserveIndices(IDBlockSize);
+        if (first != EntityIndexMask) {
+            blockNext = first;
+            blockEnd = first + IDBlockSize;
+        }
+    }
+    if (blockNext != blockEnd) {
+        id = MakeEntityID(blockNext++, 0);
+    } else {
+        // No room for a whole block near the end of the index space
+        id = world.ReserveEntity();
+        if (id == NullEntity) return NullEntity;
+    }
+
+    commands.push_back({CommandType::CreateEntity, id, 0, creates.size()});
+    creates.push_back({std::move(mesh), TagTable::Intern(tag)});
+    return id;
+}
+
+void CommandBuffer::ReleaseUnusedIDs() {
+    world.ReleaseReservedIndices(blockNext, blockEnd - blockNext);
+    blockNext = blockEnd = 0;
+}
+
+void CommandBuffer::DestroyEntity(EntityID id) {
+    commands.push_back({CommandType::DestroyEntity, id, 0, 0});
+}
+
+void CommandBuffer::Playback() {
+    if (commands.empty()) return;
+
+    // Grow each pool once for the whole batch instead of per insert
+    std::vector<std::size_t> adds(staging.size(), 0);
+    for (const Command& c : commands) {
+        if (c.type == CommandType::AddComponent) adds[c.component]++;
+    }
+    if (!creates.empty()) {
+        auto& entities = world.Storage<Entity>();
+        entities.Reserve(entities.Size() + creates.size());
+    }
+    for (std::size_t type = 0; type < staging.size(); ++type) {
+        if (adds[type] > 0) staging[type]->Reserve(world, adds[type]);
+    }
+
+    for (const Command& c : commands) {
+        switch (c.type) {
+        case CommandType::CreateEntity: {
+            PendingCreate& create = creates[c.payload];
+            world.CreateReservedEntity(c.id, std::move(create.mesh), create.tag);
+            break;
+        }
+        case CommandType::DestroyEntity:
+            world.DestroyEntity(c.id);
+            break;
+        case CommandType::AddComponent:
+            staging[c.component]->Add(world, c.id, c.payload);
+            break;
+        case CommandType::RemoveComponent:
+            staging[c.component]->Remove(world, c.id);
+            break;
+        }
+    }
+
+    commands.clear();
+    creates.clear();
+    for (auto& staged : staging) {
+        if (staged) staged->Clear();
+    }
+}
+
+CommandBuffer& ECS::Commands() {
+    return CurrentWorld().Commands();
+}
+
+void ECS::FlushCommands() {
+    CurrentWorld().FlushCommands();
+}
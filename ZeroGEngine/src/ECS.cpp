@@ -1,135 +1,148 @@
 #include "ECS.hpp"
 
-// Static storage for each component type
-template <typename T>
-std::unordered_map<EntityID, T>& ECS::componentStorage() {
-    static std::unordered_map<EntityID, T> storage;
-    return storage;
+#include <iostream>
+
+thread_local World* ECS::detail::currentWorld = nullptr;
+
+World& ECS::DefaultWorld() {
+    static World world;
+    return world;
+}
+
+void ECS::SetCurrentWorld(World* world) {
+    detail::currentWorld = world;
 }
 
 // Entity creation
 
 EntityID ECS::CreateEntity(std::shared_ptr<Mesh> mesh, const std::string& tag) {
-    static EntityID nextID = 0;
-    EntityID newID = nextID++;
-    Entity newEntity;
-    newEntity.mesh = mesh;
-    newEntity.tag = tag;
+    return CurrentWorld().CreateEntity(std::move(mesh), tag);
+}
+
+EntityRange ECS::CreateEntities(std::uint32_t count, std::shared_ptr<Mesh> mesh, const std::string& tag) {
+    return CurrentWorld().CreateEntities(count, std::move(mesh), tag);
+}
 
-    // Register the entity in the global entity map using move semantics
-    componentStorage<Entity>()[newID] = std::move(newEntity);
+EntityID ECS::ReserveEntity() {
+    return CurrentWorld().ReserveEntity();
+}
 
-    return newID;
+bool ECS::CreateReservedEntity(EntityID id, std::shared_ptr<Mesh> mesh, const std::string& tag) {
+    return CurrentWorld().CreateReservedEntity(id, std::move(mesh), tag);
 }
 
 
-// Entity existence check
+// Entity existence check: a stale handle fails the generation compare
 bool ECS::HasEntity(EntityID id) {
-    return componentStorage<Entity>().find(id) != componentStorage<Entity>().end();
+    return CurrentWorld().HasEntity(id);
 }
 
 // Get entity by ID
 Entity* ECS::GetEntity(EntityID id) {
-    if (HasEntity(id)) {
-        return &componentStorage<Entity>()[id];
-    }
-    return nullptr;
+    return CurrentWorld().GetEntity(id);
 }
 
 // Destroy an entity and clean up associated components
 void ECS::DestroyEntity(EntityID id) {
-    if (HasEntity(id)) {
-        componentStorage<Entity>().erase(id);
-        componentStorage<PhysicsComponent>().erase(id);
-        componentStorage<TransformComponent>().erase(id);
-        componentStorage<CameraComponent>().erase(id);
-    }
+    CurrentWorld().DestroyEntity(id);
 }
 
 // Clear all entities and components
 void ECS::Clear() {
-    componentStorage<Entity>().clear();
-    componentStorage<PhysicsComponent>().clear();
-    componentStorage<TransformComponent>().clear();
-    componentStorage<CameraComponent>().clear();
+    CurrentWorld().Clear();
 }
 
-// Add components
+// Add components (ignored for dead or stale handles)
 void ECS::AddPhysics(EntityID id, const PhysicsComponent& p) {
-    if (!HasPhysics(id)) {
-        componentStorage<PhysicsComponent>()[id] = p;
-    }
+    CurrentWorld().Add(id, p);
 }
 
 PhysicsComponent* ECS::GetPhysics(EntityID id) {
-    if (HasPhysics(id)) {
-        return &componentStorage<PhysicsComponent>()[id];
-    }
-    return nullptr;
+    return CurrentWorld().Get<PhysicsComponent>(id);
 }
 
 bool ECS::HasPhysics(EntityID id) {
-    return componentStorage<PhysicsComponent>().find(id) != componentStorage<PhysicsComponent>().end();
+    return CurrentWorld().Has<PhysicsComponent>(id);
 }
 
 void ECS::AddTransform(EntityID id, const TransformComponent& t) {
-    if (!HasTransform(id)) {
-        componentStorage<TransformComponent>()[id] = t;
-    }
+    CurrentWorld().Add(id, t);
 }
 
 TransformComponent* ECS::GetTransform(EntityID id) {
-    if (HasTransform(id)) {
-        return &componentStorage<TransformComponent>()[id];
-    }
-    return nullptr;
+    return CurrentWorld().Get<TransformComponent>(id);
 }
 
 bool ECS::HasTransform(EntityID id) {
-    return componentStorage<TransformComponent>().find(id) != componentStorage<TransformComponent>().end();
+    return CurrentWorld().Has<TransformComponent>(id);
 }
 
 void ECS::AddCamera(EntityID id, const CameraComponent& c) {
-    if (!HasCamera(id)) {
-        componentStorage<CameraComponent>()[id] = c;
-    }
+    CurrentWorld().Add(id, c);
 }
 
 CameraComponent* ECS::GetCamera(EntityID id) {
-    if (HasCamera(id)) {
-        return &componentStorage<CameraComponent>()[id];
-    }
-    return nullptr;
+    return CurrentWorld().Get<CameraComponent>(id);
 }
 
 bool ECS::HasCamera(EntityID id) {
-    return componentStorage<CameraComponent>().find(id) != componentStorage<CameraComponent>().end();
+    return CurrentWorld().Has<CameraComponent>(id);
 }
 
-// Get all entities
-const std::unordered_map<EntityID, Entity>& ECS::GetAllEntities() {
-    return componentStorage<Entity>();
+void ECS::RefreshCameras() {
+    for (CameraComponent& camera : CurrentWorld().Storage<CameraComponent>()) camera.Refresh();
+}
+
+// Parent/child links
+bool ECS::SetParent(EntityID child, EntityID parent) {
+    World& world = CurrentWorld();
+    if (!world.HasEntity(child)) return false;
+
+    if (parent == NullEntity) {
+        world.Remove<HierarchyComponent>(child);
+        return true;
+    }
+    if (!world.HasEntity(parent)) return false;
+
+    // Walk up from the new parent; meeting the child means a cycle
+    for (EntityID up = parent; up != NullEntity; ) {
+        if (up == child) {
+            std::cerr << "ECS: refusing to parent " << child << " under its own descendant " << parent << "\n";
+            return false;
+        }
+        const HierarchyComponent* link = world.Read<HierarchyComponent>(up);
+        up = link ? link->parent : NullEntity;
+    }
+
+    if (HierarchyComponent* link = world.Get<HierarchyComponent>(child)) {
+        link->parent = parent;
+    } else {
+        world.Add(child, HierarchyComponent{parent});
+    }
+    return true;
 }
 
-// Get component by type
-template <typename T>
-T* ECS::GetComponent(EntityID id) {
-    auto& components = componentStorage<T>();
-    auto it = components.find(id);
-    return (it != components.end()) ? &it->second : nullptr;
+EntityID ECS::GetParent(EntityID child) {
+    const HierarchyComponent* link = CurrentWorld().Read<HierarchyComponent>(child);
+    return link ? link->parent : NullEntity;
+}
+
+// Get all entities
+const ComponentPool<Entity>& ECS::GetAllEntities() {
+    return CurrentWorld().Storage<Entity>();
 }
 
 // Get the tag of an entity
-std::string ECS::GetTag(EntityID id) {
-    if (HasEntity(id)) {
-        return componentStorage<Entity>()[id].tag;
-    }
-    return "";
+const std::string& ECS::GetTag(EntityID id) {
+    return CurrentWorld().GetTag(id);
 }
 
 // Set the tag of an entity
 void ECS::SetTag(EntityID id, const std::string& tag) {
-    if (HasEntity(id)) {
-        componentStorage<Entity>()[id].tag = tag;
-    }
+    CurrentWorld().SetTag(id, tag);
+}
+
+// Look up entities by tag
+const std::vector<EntityID>& ECS::FindByTag(std::string_view tag) {
+    return CurrentWorld().FindByTag(tag);
 }
@@ -0,0 +1,181 @@
+#include "Frustum.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ZEROG_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+Frustum Frustum::FromMatrix(const glm::mat4& m) {
+    // Gribb/Hartmann: each plane is the last row of the matrix plus or minus
+    // one of the others (glm is column-major, so row r is m[0][r]..m[3][r])
+    auto row = [&m](int r) { return glm::vec4(m[0][r], m[1][r], m[2][r], m[3][r]); };
+    glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+    Frustum frustum;
+    frustum.planes[0] = r3 + r0;
+    frustum.planes[1] = r3 - r0;
+    frustum.planes[2] = r3 + r1;
+    frustum.planes[3] = r3 - r1;
+    frustum.planes[4] = r3 + r2;
+    frustum.planes[5] = r3 - r2;
+    return frustum;
+}
+
+bool Frustum::Intersects(const glm::vec3& center, const glm::vec3& extent) const {
+    for (const glm::vec4& p : planes) {
+        float distance = p.x * center.x + p.y * center.y + p.z * center.z + p.w;
+        float radius = std::fabs(p.x) * extent.x + std::fabs(p.y) * extent.y + std::fabs(p.z) * extent.z;
+        if (distance + radius < 0.0f) return false;
+    }
+    return true;
+}
+
+void TransformBounds(const glm::mat4& model, const glm::vec3& localMin, const glm::vec3& localMax,
+                     glm::vec3& center, glm::vec3& extent) {
+    glm::vec3 c((localMin.x + localMax.x) * 0.5f, (localMin.y + localMax.y) * 0.5f, (localMin.z + localMax.z) * 0.5f);
+    glm::vec3 e((localMax.x - localMin.x) * 0.5f, (localMax.y - localMin.y) * 0.5f, (localMax.z - localMin.z) * 0.5f);
+
+    for (int r = 0; r < 3; ++r) {
+        center[r] = model[0][r] * c.x + model[1][r] * c.y + model[2][r] * c.z + model[3][r];
+        extent[r] = std::fabs(model[0][r]) * e.x + std::fabs(model[1][r]) * e.y + std::fabs(model[2][r]) * e.z;
+    }
+}
+
+// ---------- SoA storage ----------
+
+void BoundsSoA::Clear() {
+    for (AlignedVector<float>* field : {&cx, &cy, &cz, &ex, &ey, &ez}) field->clear();
+}
+
+void BoundsSoA::Reserve(std::size_t count) {
+    for (AlignedVector<float>* field : {&cx, &cy, &cz, &ex, &ey, &ez}) field->reserve(count);
+}
+
+void BoundsSoA::Push(const glm::vec3& center, const glm::vec3& extent) {
+    cx.push_back(center.x);
+    cy.push_back(center.y);
+    cz.push_back(center.z);
+    ex.push_back(extent.x);
+    ey.push_back(extent.y);
+    ez.push_back(extent.z);
+}
+
+// ---------- Culling kernels ----------
+
+namespace {
+
+    // Plane coefficients with the absolute normals the extent test needs
+    struct PlaneSet {
+        float nx[6], ny[6], nz[6], d[6];
+        float ax[6], ay[6], az[6];
+
+        explicit PlaneSet(const Frustum& frustum) {
+            for (int p = 0; p < 6; ++p) {
+                const glm::vec4& plane = frustum.planes[p];
+                nx[p] = plane.x;
+                ny[p] = plane.y;
+                nz[p] = plane.z;
+                d[p] = plane.w;
+                ax[p] = std::fabs(plane.x);
+                ay[p] = std::fabs(plane.y);
+                az[p] = std::fabs(plane.z);
+            }
+        }
+    };
+
+    std::size_t CullScalar(const PlaneSet& planes, const BoundsSoA& boxes, std::uint8_t* visible,
+                           std::size_t begin, std::size_t end) {
+        std::size_t count = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            bool inside = true;
+            for (int p = 0; p < 6 && inside; ++p) {
+                float distance = planes.nx[p] * boxes.cx[i] + planes.ny[p] * boxes.cy[i] + planes.nz[p] * boxes.cz[i] + planes.d[p];
+                float radius = planes.ax[p] * boxes.ex[i] + planes.ay[p] * boxes.ey[i] + planes.az[p] * boxes.ez[i];
+                inside = distance + radius >= 0.0f;
+            }
+            visible[i] = inside;
+            count += inside;
+        }
+        return count;
+    }
+
+#ifdef ZEROG_X86_SIMD
+
+    __attribute__((target("sse2")))
+    std::size_t CullSSE2(const PlaneSet& planes, const BoundsSoA& boxes, std::uint8_t* visible) {
+        const std::size_t n = boxes.Size();
+        std::size_t count = 0;
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128 cx = _mm_load_ps(&boxes.cx[i]), cy = _mm_load_ps(&boxes.cy[i]), cz = _mm_load_ps(&boxes.cz[i]);
+            __m128 ex = _mm_load_ps(&boxes.ex[i]), ey = _mm_load_ps(&boxes.ey[i]), ez = _mm_load_ps(&boxes.ez[i]);
+
+            // A lane is culled once distance + radius < 0 for any plane
+            __m128 outside = _mm_setzero_ps();
+            for (int p = 0; p < 6; ++p) {
+                __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.nx[p]), cx),
+                                                        _mm_mul_ps(_mm_set1_ps(planes.ny[p]), cy)),
+                                             _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.nz[p]), cz), _mm_set1_ps(planes.d[p])));
+                __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.ax[p]), ex),
+                                                      _mm_mul_ps(_mm_set1_ps(planes.ay[p]), ey)),
+                                           _mm_mul_ps(_mm_set1_ps(planes.az[p]), ez));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+            }
+
+            int mask = ~_mm_movemask_ps(outside) & 0xf;
+            for (int lane = 0; lane < 4; ++lane) visible[i + lane] = (mask >> lane) & 1;
+            count += __builtin_popcount(mask);
+        }
+        return count + CullScalar(planes, boxes, visible, i, n);
+    }
+
+    __attribute__((target("avx2")))
+    std::size_t CullAVX2(const PlaneSet& planes, const BoundsSoA& boxes, std::uint8_t* visible) {
+        const std::size_t n = boxes.Size();
+        std::size_t count = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 cx = _mm256_load_ps(&boxes.cx[i]), cy = _mm256_load_ps(&boxes.cy[i]), cz = _mm256_load_ps(&boxes.cz[i]);
+            __m256 ex = _mm256_load_ps(&boxes.ex[i]), ey = _mm256_load_ps(&boxes.ey[i]), ez = _mm256_load_ps(&boxes.ez[i]);
+
+            __m256 outside = _mm256_setzero_ps();
+            for (int p = 0; p < 6; ++p) {
+                __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.nx[p]), cx),
+                                                              _mm256_mul_ps(_mm256_set1_ps(planes.ny[p]), cy)),
+                                                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.nz[p]), cz),
+                                                              _mm256_set1_ps(planes.d[p])));
+                __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.ax[p]), ex),
+                                                            _mm256_mul_ps(_mm256_set1_ps(planes.ay[p]), ey)),
+                                              _mm256_mul_ps(_mm256_set1_ps(planes.az[p]), ez));
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_LT_OQ));
+            }
+
+            int mask = ~_mm256_movemask_ps(outside) & 0xff;
+            for (int lane = 0; lane < 8; ++lane) visible[i + lane] = (mask >> lane) & 1;
+            count += __builtin_popcount(mask);
+        }
+        return count + CullScalar(planes, boxes, visible, i, n);
+    }
+
+#endif  // ZEROG_X86_SIMD
+
+}  // namespace
+
+std::size_t CullBoxes(const Frustum& frustum, const BoundsSoA& boxes, std::uint8_t* visible) {
+    return CullBoxes(frustum, boxes, visible, ActiveSimdPath());
+}
+
+std::size_t CullBoxes(const Frustum& frustum, const BoundsSoA& boxes, std::uint8_t* visible, SimdPath path) {
+    PlaneSet planes(frustum);
+
+    switch (std::min(path, ActiveSimdPath())) {
+#ifdef ZEROG_X86_SIMD
+    case SimdPath::AVX2: return CullAVX2(planes, boxes, visible);
+    case SimdPath::SSE2: return CullSSE2(planes, boxes, visible);
+#endif
+    default: return CullScalar(planes, boxes, visible, 0, boxes.Size());
+    }
+}
@@ -0,0 +1,99 @@
+#include "JobSystem.hpp"
+
+#include <algorithm>
+
+JobSystem::JobSystem(unsigned workerCount) {
+    if (workerCount == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? hw - 1 : 0;
+    }
+    workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& w : workers) w.join();
+}
+
+void JobSystem::Submit(std::function<void()> job, JobCounter& counter) {
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+    Submit([job = std::move(job), &counter] {
+        job();
+        counter.pending.fetch_sub(1, std::memory_order_release);
+    });
+}
+
+void JobSystem::Submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(job));
+    }
+    wake.notify_one();
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    while (counter.pending.load(std::memory_order_acquire) > 0) {
+        if (!RunOne()) std::this_thread::yield();
+    }
+}
+
+void JobSystem::HelpUntil(const std::function<bool()>& done) {
+    while (!done()) {
+        if (!RunOne()) std::this_thread::yield();
+    }
+}
+
+void JobSystem::ParallelFor(std::size_t count, std::size_t grain,
+                            const std::function<void(std::size_t, std::size_t)>& fn) {
+    if (count == 0) return;
+    grain = std::max<std::size_t>(grain, 1);
+
+    // Aim for a few chunks per thread so uneven chunks still balance
+    std::size_t threads = workers.size() + 1;
+    std::size_t chunk = std::max(grain, (count + threads * 4 - 1) / (threads * 4));
+    if (chunk >= count || workers.empty()) {
+        fn(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (std::size_t begin = chunk; begin < count; begin += chunk) {
+        std::size_t end = std::min(begin + chunk, count);
+        Submit([&fn, begin, end] { fn(begin, end); }, counter);
+    }
+    fn(0, chunk); // first chunk on the calling thread
+    Wait(counter);
+}
+
+bool JobSystem::RunOne() {
+    std::function<void()> job;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) return false;
+        job = std::move(queue.front());
+        queue.pop_front();
+    }
+    job();
+    return true;
+}
+
+void JobSystem::WorkerLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping && queue.empty()) return;
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        job();
+    }
+}
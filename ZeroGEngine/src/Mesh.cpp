@@ -92,13 +92,21 @@ static void buildSphere(std::vector<float>& v, std::vector<unsigned int>& i, int
 
 // helper builders (buildCube, buildPyramid, buildSphere)...
 
-Mesh::Mesh(MeshType t) : type(t) {
+Mesh::Mesh(MeshType t, const MeshParams& params) : type(t) {
     if (type == MeshType::Cube) buildCube(vertices, indices);
     else if (type == MeshType::Pyramid) buildPyramid(vertices, indices);
-    else if (type == MeshType::Sphere) buildSphere(vertices, indices);
+    else if (type == MeshType::Sphere) buildSphere(vertices, indices, params.latBands, params.longBands);
 
     indexCount = static_cast<unsigned int>(indices.size());
 
+    // pos(3) color(3) per vertex
+    for (std::size_t v = 0; v + 6 <= vertices.size(); v += 6) {
+        glm::vec3 p(vertices[v], vertices[v + 1], vertices[v + 2]);
+        if (v == 0) boundsMin = boundsMax = p;
+        boundsMin = glm::min(boundsMin, p);
+        boundsMax = glm::max(boundsMax, p);
+    }
+
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
     glGenBuffers(1, &EBO);
@@ -139,6 +147,7 @@ Mesh::Mesh(Mesh&& o) noexcept {
     vertices = std::move(o.vertices);
     indices = std::move(o.indices);
     VAO = o.VAO; VBO = o.VBO; EBO = o.EBO; indexCount = o.indexCount;
+    boundsMin = o.boundsMin; boundsMax = o.boundsMax;
     o.VAO = o.VBO = o.EBO = 0; o.indexCount = 0;
 }
 
@@ -152,6 +161,7 @@ Mesh& Mesh::operator=(Mesh&& o) noexcept {
         vertices = std::move(o.vertices);
         indices = std::move(o.indices);
         VAO = o.VAO; VBO = o.VBO; EBO = o.EBO; indexCount = o.indexCount;
+        boundsMin = o.boundsMin; boundsMax = o.boundsMax;
         o.VAO = o.VBO = o.EBO = 0; o.indexCount = 0;
     }
     return *this;
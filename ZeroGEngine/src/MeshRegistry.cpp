@@ -0,0 +1,77 @@
+#include "MeshRegistry.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace {
+
+    struct Key {
+        MeshType type;
+        int latBands;
+        int longBands;
+
+        bool operator<(const Key& other) const {
+            return std::tie(type, latBands, longBands) < std::tie(other.type, other.latBands, other.longBands);
+        }
+    };
+
+    // Parameters a type does not use are zeroed, so they can't split the cache
+    Key MakeKey(MeshType type, const MeshParams& params) {
+        if (type == MeshType::Sphere) {
+            return {type, std::max(params.latBands, 2), std::max(params.longBands, 3)};
+        }
+        return {type, 0, 0};
+    }
+
+    struct Registry {
+        std::mutex mutex;
+        std::map<Key, std::weak_ptr<Mesh>> meshes;
+    };
+
+    Registry& GetRegistry() {
+        static Registry registry;
+        return registry;
+    }
+
+}  // namespace
+
+std::shared_ptr<Mesh> MeshRegistry::Get(MeshType type, const MeshParams& params) {
+    Key key = MakeKey(type, params);
+
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    std::weak_ptr<Mesh>& cached = registry.meshes[key];
+    if (std::shared_ptr<Mesh> mesh = cached.lock()) return mesh;
+
+    MeshParams clamped;
+    if (type == MeshType::Sphere) {
+        clamped.latBands = key.latBands;
+        clamped.longBands = key.longBands;
+    }
+    auto mesh = std::make_shared<Mesh>(type, clamped);
+    if (mesh->VAO == 0 || mesh->indexCount == 0) {
+        std::cerr << "MeshRegistry: failed to build mesh of type " << static_cast<int>(type) << "\n";
+    }
+    cached = mesh;
+    return mesh;
+}
+
+std::size_t MeshRegistry::Count() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    std::size_t count = 0;
+    for (auto it = registry.meshes.begin(); it != registry.meshes.end();) {
+        if (it->second.expired()) {
+            it = registry.meshes.erase(it);
+        } else {
+            ++count;
+            ++it;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,129 @@
+#include "MeshTable.hpp"
+
+#include <array>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    struct Slot {
+        std::shared_ptr<Mesh> mesh;
+        std::uint32_t refs = 0;
+    };
+
+    // Fixed page directory: pages are never moved, so Get() can index them
+    // without taking the lock while other threads register meshes
+    constexpr std::uint32_t PageBits = 10;
+    constexpr std::uint32_t PageSize = 1u << PageBits;
+    constexpr std::uint32_t MaxPages = 1024;
+
+    struct Table {
+        std::mutex mutex;
+        std::array<std::unique_ptr<Slot[]>, MaxPages> pages;
+        std::uint32_t nextHandle = 1; // 0 is NullMesh
+        std::vector<MeshHandle> freeList;
+        std::unordered_map<const Mesh*, MeshHandle> byPointer;
+        std::vector<std::shared_ptr<Mesh>> released; // freed by CollectGarbage()
+        std::size_t count = 0;
+
+        Slot& At(MeshHandle handle) { return pages[handle >> PageBits][handle & (PageSize - 1)]; }
+    };
+
+    Table& GetTable() {
+        static Table table;
+        return table;
+    }
+
+}  // namespace
+
+MeshHandle MeshTable::Acquire(std::shared_ptr<Mesh> mesh, std::uint32_t refs) {
+    if (!mesh) return NullMesh;
+
+    Table& table = GetTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    auto found = table.byPointer.find(mesh.get());
+    if (found != table.byPointer.end()) {
+        table.At(found->second).refs += refs;
+        return found->second;
+    }
+
+    MeshHandle handle;
+    if (!table.freeList.empty()) {
+        handle = table.freeList.back();
+        table.freeList.pop_back();
+    } else {
+        if (table.nextHandle >= MaxPages * PageSize) {
+            std::cerr << "MeshTable: mesh limit reached (" << MaxPages * PageSize << ")\n";
+            return NullMesh;
+        }
+        handle = table.nextHandle++;
+        auto& page = table.pages[handle >> PageBits];
+        if (!page) page = std::make_unique<Slot[]>(PageSize);
+    }
+
+    Slot& slot = table.At(handle);
+    table.byPointer.emplace(mesh.get(), handle);
+    slot.mesh = std::move(mesh);
+    slot.refs = refs;
+    table.count++;
+    return handle;
+}
+
+void MeshTable::Retain(MeshHandle handle, std::uint32_t refs) {
+    if (handle == NullMesh) return;
+
+    Table& table = GetTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    table.At(handle).refs += refs;
+}
+
+bool MeshTable::TryRetain(MeshHandle handle, std::uint32_t refs) {
+    if (handle == NullMesh || handle >= MaxPages * PageSize) return false;
+
+    Table& table = GetTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    if (!table.pages[handle >> PageBits]) return false;
+
+    Slot& slot = table.At(handle);
+    if (!slot.mesh) return false;
+    slot.refs += refs;
+    return true;
+}
+
+void MeshTable::Release(MeshHandle handle) {
+    if (handle == NullMesh) return;
+
+    Table& table = GetTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    Slot& slot = table.At(handle);
+    if (slot.refs == 0 || --slot.refs > 0) return;
+
+    table.byPointer.erase(slot.mesh.get());
+    table.released.push_back(std::move(slot.mesh));
+    table.freeList.push_back(handle);
+    table.count--;
+}
+
+void MeshTable::CollectGarbage() {
+    std::vector<std::shared_ptr<Mesh>> released;
+    {
+        Table& table = GetTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        released.swap(table.released);
+    }
+    // GL objects are deleted here, outside the lock
+}
+
+Mesh* MeshTable::Get(MeshHandle handle) {
+    if (handle == NullMesh) return nullptr;
+    return GetTable().At(handle).mesh.get();
+}
+
+std::size_t MeshTable::Count() {
+    Table& table = GetTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.count;
+}
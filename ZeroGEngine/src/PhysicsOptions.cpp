@@ -0,0 +1,64 @@
+#include "PhysicsOptions.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+
+bool PhysicsOptions::operator==(const PhysicsOptions &other) const {
+  return shapeType == other.shapeType && dimensions == other.dimensions &&
+         isKinematic == other.isKinematic && mass == other.mass &&
+         staticFriction == other.staticFriction &&
+         dynamicFriction == other.dynamicFriction &&
+         restitution == other.restitution && isStatic == other.isStatic;
+}
+
+namespace {
+
+struct OptionsHash {
+  std::size_t operator()(const PhysicsOptions &o) const {
+    std::hash<float> hf;
+    std::size_t h = static_cast<std::size_t>(o.shapeType);
+    auto mix = [&h](std::size_t v) {
+      h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    };
+    mix(hf(o.dimensions.x));
+    mix(hf(o.dimensions.y));
+    mix(hf(o.dimensions.z));
+    mix(hf(o.mass));
+    mix(hf(o.staticFriction));
+    mix(hf(o.dynamicFriction));
+    mix(hf(o.restitution));
+    mix((o.isKinematic ? 1u : 0u) | (o.isStatic ? 2u : 0u));
+    return h;
+  }
+};
+
+} // namespace
+
+std::shared_ptr<const PhysicsOptions>
+PhysicsOptions::Intern(const PhysicsOptions &opts) {
+  static std::mutex mutex;
+  static std::unordered_map<PhysicsOptions, std::weak_ptr<const PhysicsOptions>,
+                            OptionsHash>
+      interned;
+  static std::size_t pruneAt = 64;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::weak_ptr<const PhysicsOptions> &cached = interned[opts];
+  if (auto shared = cached.lock())
+    return shared;
+
+  auto shared = std::make_shared<const PhysicsOptions>(opts);
+  cached = shared;
+
+  // Drop entries whose options have been freed, once the table has doubled
+  // since the last sweep, so it stays within twice the live count
+  if (interned.size() >= pruneAt) {
+    for (auto it = interned.begin(); it != interned.end();)
+      it = it->second.expired() ? interned.erase(it) : std::next(it);
+    pruneAt = std::max<std::size_t>(64, interned.size() * 2);
+  }
+  return shared;
+}
@@ -2,11 +2,13 @@
 #include "PhysicsSystem.hpp"
 #include "ECS.hpp"
 #include "TransformComponent.hpp"
+#include "View.hpp"
 #include <glm/gtc/quaternion.hpp>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <algorithm>
 #include <glm/gtx/euler_angles.hpp>
 #include <iostream>
+#include <mutex>
 
 using namespace physx;
 
@@ -24,6 +26,24 @@ private:
   PxU32 mWorkerCount;
 };
 
+// ---------- Dispatcher that runs PhysX tasks on the engine job system ----------
+class JobCpuDispatcher : public PxCpuDispatcher {
+public:
+  explicit JobCpuDispatcher(JobSystem &jobs) : mJobs(jobs) {}
+  virtual void submitTask(PxBaseTask &task) override {
+    mJobs.Submit([&task] {
+      task.run();
+      task.release();
+    });
+  }
+  virtual PxU32 getWorkerCount() const override {
+    return mJobs.WorkerCount();
+  }
+
+private:
+  JobSystem &mJobs;
+};
+
 // ---------- Improved filter shader ----------
 static PxFilterFlags SimpleFilterShader(PxFilterObjectAttributes attributes0,
                                         PxFilterData filterData0,
@@ -72,34 +92,102 @@ static inline glm::vec3 pxToGlmVec3(const PxVec3 &v) {
 }
 
 // ---------- PhysicsSystem implementation ----------
-PhysicsSystem::PhysicsSystem() {
+PhysicsSystem::PhysicsSystem(World &world_) : world(world_) {
   // Reserve some capacity to avoid frequent reallocations
-  dynamicEntities.reserve(100);
   entityToActor.reserve(100);
+
+  // Keep the actor table in sync with the ECS instead of polling it
+  addObserver = world.OnAdd<PhysicsComponent>(
+      [this](World &, const std::vector<EntityID> &added) {
+        OnPhysicsAdded(added);
+      });
+  removeObserver = world.OnRemove<PhysicsComponent>(
+      [this](World &, const std::vector<EntityID> &removed) {
+        for (EntityID entityId : removed)
+          RemoveActor(entityId);
+        ProcessPendingRemovals();
+      });
+}
+
+// Bodies added at runtime (e.g. spawned through a command buffer) get an
+// actor as soon as the additions are delivered
+void PhysicsSystem::OnPhysicsAdded(const std::vector<EntityID> &added) {
+  if (!scene)
+    return;
+
+  for (EntityID entityId : added) {
+    if (entityToActor.find(entityId) != entityToActor.end() ||
+        !world.Has<TransformComponent>(entityId))
+      continue;
+
+    Entity *entity = world.GetEntity(entityId);
+    PhysicsComponent *physicsComp = world.Get<PhysicsComponent>(entityId);
+    if (entity && physicsComp)
+      CreatePhysXActor(*entity, *physicsComp);
+  }
 }
 
-void PhysicsSystem::Init() {
+// ---------- Shared PhysX SDK ----------
+// PhysX allows one foundation per process, so every PhysicsSystem (one per
+// world) shares the foundation and PxPhysics and only owns its own scene.
+static std::mutex gSdkMutex;
+static int gSdkUsers = 0;
+static PxFoundation *gFoundation = nullptr;
+static PxPhysics *gPhysics = nullptr;
+
+static bool AcquireSdk(PxFoundation *&foundation, PxPhysics *&physics) {
   static PxDefaultAllocator gAllocator;
   static SimpleErrorCallback gErrorCallback;
 
-  foundation =
-      PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
-  if (!foundation) {
-    std::cerr << "PxCreateFoundation failed\n";
-    return;
+  std::lock_guard<std::mutex> lock(gSdkMutex);
+  if (gSdkUsers == 0) {
+    gFoundation =
+        PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+    if (!gFoundation) {
+      std::cerr << "PxCreateFoundation failed\n";
+      return false;
+    }
+
+    PxTolerancesScale toleranceScale;
+    toleranceScale.length = 1.0f; // Typical object size is 1 unit
+    toleranceScale.speed = 10.0f; // Typical speed is 10 units/second
+    gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation,
+                               toleranceScale, true, nullptr);
+    if (!gPhysics) {
+      std::cerr << "PxCreatePhysics failed\n";
+      gFoundation->release();
+      gFoundation = nullptr;
+      return false;
+    }
   }
+  gSdkUsers++;
+  foundation = gFoundation;
+  physics = gPhysics;
+  return true;
+}
 
-  PxTolerancesScale toleranceScale;
-  toleranceScale.length = 1.0f; // Typical object size is 1 unit
-  toleranceScale.speed = 10.0f; // Typical speed is 10 units/second
-  physics = PxCreatePhysics(PX_PHYSICS_VERSION, *foundation, toleranceScale,
-                            true, nullptr);
-  if (!physics) {
-    std::cerr << "PxCreatePhysics failed\n";
-    return;
+static void ReleaseSdk() {
+  std::lock_guard<std::mutex> lock(gSdkMutex);
+  if (--gSdkUsers == 0) {
+    gPhysics->release();
+    gFoundation->release();
+    gPhysics = nullptr;
+    gFoundation = nullptr;
   }
+}
 
-  dispatcher = new SimpleCpuDispatcher(1);
+void PhysicsSystem::Init(JobSystem *jobs) {
+  if (physics || !AcquireSdk(foundation, physics))
+    return;
+
+  // Spread simulation tasks over the job system when there are workers to
+  // run them; FixedUpdate helps drain the queue while the step is running
+  if (jobs && jobs->WorkerCount() > 0) {
+    dispatcher = new JobCpuDispatcher(*jobs);
+    taskJobs = jobs;
+  } else {
+    dispatcher = new SimpleCpuDispatcher(1);
+  }
 
   PxSceneDesc sceneDesc(physics->getTolerancesScale());
   sceneDesc.gravity = PxVec3(0.f, -9.81f, 0.f);
@@ -140,7 +228,7 @@ void PhysicsSystem::CreatePhysXActor(Entity &entity,
     return;
   }
 
-  auto *t = ECS::GetTransform(entity.id);
+  const auto *t = world.Read<TransformComponent>(entity.id);
   if (!t)
     return;
 
@@ -244,10 +332,6 @@ void PhysicsSystem::CreatePhysXActor(Entity &entity,
     }
 
     actor = body;
-
-    // Track dynamic/kinematic actors for updates
-    dynamicEntities.push_back(entity.id);
-    std::cout << "  Added to dynamic entities list" << std::endl;
   } else {
     // Static actor
     PxRigidStatic *body = physics->createRigidStatic(pose);
@@ -318,23 +402,15 @@ void PhysicsSystem::RemoveActor(EntityID entityId) {
 }
 
 void PhysicsSystem::ProcessPendingRemovals() {
+  if (pendingRemovals.empty())
+    return;
+
   for (EntityID entityId : pendingRemovals) {
     auto it = entityToActor.find(entityId);
     if (it != entityToActor.end()) {
       CleanupActor(entityId, it->second);
       entityToActor.erase(it);
     }
-
-    // Remove from dynamic entities list
-    auto dynIt =
-        std::find(dynamicEntities.begin(), dynamicEntities.end(), entityId);
-    if (dynIt != dynamicEntities.end()) {
-      // Efficient removal: swap with last element and pop
-      if (dynIt != dynamicEntities.end() - 1) {
-        *dynIt = dynamicEntities.back();
-      }
-      dynamicEntities.pop_back();
-    }
   }
   pendingRemovals.clear();
 }
@@ -352,7 +428,7 @@ void PhysicsSystem::CleanupActor(EntityID entityId, PxRigidActor *actor) {
   actor->release();
 
   // Clear physics component reference
-  auto *physicsComp = ECS::GetPhysics(entityId);
+  auto *physicsComp = world.Get<PhysicsComponent>(entityId);
   if (physicsComp) {
     physicsComp->pxActor = nullptr;
   }
@@ -367,17 +443,20 @@ void PhysicsSystem::FixedUpdate(float timestep) {
 
   // Run physics simulation
   scene->simulate(timestep);
+  // Never block inside fetchResults while our tasks sit in the job queue:
+  // if every worker is itself waiting on a step (one world per worker, or
+  // several physics systems in one stage) nobody would be left to run them
+  if (taskJobs)
+    taskJobs->HelpUntil([this] { return scene->checkResults(false); });
   scene->fetchResults(true);
 
   // Check for any penetrations (debug)
-  static int debugCounter = 0;
   if (debugCounter % 120 == 0) { // Every 2 seconds at 60Hz
     std::cout << "=== Physics Debug Info ===" << std::endl;
     for (const auto &pair : entityToActor) {
-      auto *transform = ECS::GetTransform(pair.first);
-      auto *entity = ECS::GetEntity(pair.first);
-      if (transform && entity) {
-        std::cout << entity->tag << " at (" << transform->position.x << ", "
+      const auto *transform = world.Read<TransformComponent>(pair.first);
+      if (transform) {
+        std::cout << world.GetTag(pair.first) << " at (" << transform->position.x << ", "
                   << transform->position.y << ", " << transform->position.z
                   << ")" << std::endl;
       }
@@ -386,77 +465,49 @@ void PhysicsSystem::FixedUpdate(float timestep) {
   }
   debugCounter++;
 
-  // Update only dynamic entities (much faster than checking all entities)
-  for (auto it = dynamicEntities.begin(); it != dynamicEntities.end();) {
-    EntityID entityId = *it;
-
-    // Check if entity still exists
-    auto *t = ECS::GetTransform(entityId);
-    auto *physicsComp = ECS::GetPhysics(entityId);
-
-    if (!t || !physicsComp) {
-      // Entity was destroyed, remove it
-      RemoveActor(entityId);
-      // Note: actual removal happens in ProcessPendingRemovals()
-      ++it;
-      continue;
-    }
-
-    // Get the actor
-    auto actorIt = entityToActor.find(entityId);
-    if (actorIt == entityToActor.end()) {
-      // Actor missing, remove from dynamic list
-      it = dynamicEntities.erase(it);
-      continue;
-    }
-
-    PxRigidActor *actor = actorIt->second;
-    if (!actor) {
-      // Invalid actor, clean up
-      RemoveActor(entityId);
-      ++it;
-      continue;
-    }
-
-    // Verify actor is still in scene
-    if (actor->getScene() != scene) {
-      RemoveActor(entityId);
-      ++it;
-      continue;
-    }
+  // Write simulated poses back; the view only visits entities that have both
+  // a transform and a physics component, driven by the smaller of the two pools.
+  // Both are read-only here so that only transforms of awake bodies get
+  // stamped as changed.
+  ECS::View<const TransformComponent, const PhysicsComponent> view(world);
+  view.Each([this](EntityID entityId, const TransformComponent &,
+                   const PhysicsComponent &physicsComp) {
+    PxRigidActor *actor = physicsComp.pxActor;
+    if (!actor || actor->getScene() != scene)
+      return;
 
-    // Cast to dynamic actor for position updates
+    // Only dynamic actors move, and sleeping ones keep their pose
     PxRigidDynamic *dynamicActor = actor->is<PxRigidDynamic>();
-    if (dynamicActor) {
-      // Update transform from physics
-      PxTransform pxT = dynamicActor->getGlobalPose();
-      glm::vec3 oldPos = t->position;
-      t->position = pxToGlmVec3(pxT.p);
-
-      // Debug output - only print if position changed significantly
-      if (glm::distance(oldPos, t->position) > 0.1f) {
-        auto *entity = ECS::GetEntity(entityId);
-        std::string name = entity ? entity->tag : "Unknown";
-        std::cout << "Entity " << name << " moved to (" << t->position.x << ", "
-                  << t->position.y << ", " << t->position.z << ")" << std::endl;
-      }
+    if (!dynamicActor || dynamicActor->isSleeping())
+      return;
 
-      // Handle kinematic actors
-      if (dynamicActor->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC) {
-        // For kinematic bodies, update the target from current transform
-        PxTransform target(glmToPxVec3(t->position));
-        dynamicActor->setKinematicTarget(target);
-      }
+    // Update transform from physics
+    TransformComponent &t = *world.Get<TransformComponent>(entityId);
+    PxTransform pxT = dynamicActor->getGlobalPose();
+    glm::vec3 oldPos = t.position;
+    t.position = pxToGlmVec3(pxT.p);
+
+    // Debug output - only print if position changed significantly
+    if (glm::distance(oldPos, t.position) > 0.1f) {
+      const std::string &tag = world.GetTag(entityId);
+      const std::string &name = tag.empty() ? std::string("Unknown") : tag;
+      std::cout << "Entity " << name << " moved to (" << t.position.x << ", "
+                << t.position.y << ", " << t.position.z << ")" << std::endl;
+    }
 
-      // Update rotation
-      PxQuat q = pxT.q;
-      glm::quat gq(q.w, q.x, q.y, q.z);
-      glm::vec3 eulerRad = glm::eulerAngles(gq);
-      t->rotation = glm::degrees(eulerRad);
+    // Handle kinematic actors
+    if (dynamicActor->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC) {
+      // For kinematic bodies, update the target from current transform
+      PxTransform target(glmToPxVec3(t.position));
+      dynamicActor->setKinematicTarget(target);
     }
 
-    ++it;
-  }
+    // Update rotation
+    PxQuat q = pxT.q;
+    glm::quat gq(q.w, q.x, q.y, q.z);
+    glm::vec3 eulerRad = glm::eulerAngles(gq);
+    t.rotation = glm::degrees(eulerRad);
+  });
 }
 
 void PhysicsSystem::Integrate(Entity &entity, PhysicsComponent &physicsComp,
@@ -464,7 +515,7 @@ void PhysicsSystem::Integrate(Entity &entity, PhysicsComponent &physicsComp,
   if (physicsComp.isStatic)
     return;
 
-  auto *t = ECS::GetTransform(entity.id);
+  auto *t = world.Get<TransformComponent>(entity.id);
   if (!t)
     return;
 
@@ -475,6 +526,9 @@ void PhysicsSystem::Integrate(Entity &entity, PhysicsComponent &physicsComp,
 }
 
 PhysicsSystem::~PhysicsSystem() {
+  world.RemoveObserver(addObserver);
+  world.RemoveObserver(removeObserver);
+
   // Clean up all actors
   for (auto &pair : entityToActor) {
     if (pair.second) {
@@ -482,7 +536,6 @@ PhysicsSystem::~PhysicsSystem() {
     }
   }
   entityToActor.clear();
-  dynamicEntities.clear();
   pendingRemovals.clear();
 
   if (scene)
@@ -490,7 +543,5 @@ PhysicsSystem::~PhysicsSystem() {
   if (dispatcher)
     delete dispatcher;
   if (physics)
-    physics->release();
-  if (foundation)
-    foundation->release();
+    ReleaseSdk();
 }
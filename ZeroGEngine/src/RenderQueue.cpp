@@ -0,0 +1,54 @@
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+
+namespace {
+
+    constexpr unsigned DepthBits = 18;
+    constexpr std::uint64_t DepthMax = (std::uint64_t(1) << DepthBits) - 1;
+
+    // Maps [nearPlane, farPlane] onto the depth field, clamping what is outside
+    std::uint64_t QuantizeDepth(float depth, float nearPlane, float farPlane) {
+        float range = farPlane > nearPlane ? farPlane - nearPlane : 1.0f;
+        float t = (depth - nearPlane) / range;
+        if (!(t > 0.0f)) return 0; // also catches NaN
+        if (t >= 1.0f) return DepthMax;
+        return static_cast<std::uint64_t>(t * float(DepthMax));
+    }
+
+}  // namespace
+
+std::uint64_t RenderQueue::MakeKey(RenderPass pass, unsigned cameraSlot, unsigned int program,
+                                   MaterialHandle material, MeshHandle mesh, float depth, float nearPlane,
+                                   float farPlane) {
+    std::uint64_t z = QuantizeDepth(depth, nearPlane, farPlane);
+    if (pass == RenderPass::Transparent) z = DepthMax - z; // back to front
+
+    return (std::uint64_t(static_cast<std::uint8_t>(pass)) & 0x3) << 62 |
+           (std::uint64_t(std::min(cameraSlot, CameraSlots - 1)) & 0xf) << 58 |
+           (std::uint64_t(program) & 0xff) << 50 |
+           (std::uint64_t(material) & 0xffff) << 34 |
+           (std::uint64_t(mesh) & 0xffff) << 18 |
+           z;
+}
+
+unsigned RenderQueue::CameraSlot(const CameraComponent* camera) {
+    for (std::size_t slot = 0; slot < cameras.size(); ++slot) {
+        if (cameras[slot] == camera) return static_cast<unsigned>(slot);
+    }
+    if (cameras.size() < CameraSlots) cameras.push_back(camera);
+    return static_cast<unsigned>(cameras.size() - 1);
+}
+
+void RenderQueue::Push(RenderPass pass, unsigned int program, MaterialHandle material, MeshHandle mesh,
+                       float depth, const glm::mat4* model, const CameraComponent* camera) {
+    float nearPlane = camera ? camera->nearPlane : 0.0f;
+    float farPlane = camera ? camera->farPlane : 1.0f;
+    packets.push_back({MakeKey(pass, CameraSlot(camera), program, material, mesh, depth, nearPlane, farPlane),
+                       model, camera, program, material, mesh});
+}
+
+void RenderQueue::Sort() {
+    std::sort(packets.begin(), packets.end(),
+              [](const DrawPacket& a, const DrawPacket& b) { return a.key < b.key; });
+}
@@ -4,8 +4,30 @@
 #include <iostream>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
-#include "TextureComponent.hpp"
-#include "ECS.hpp"
+#include "Entity.hpp"
+
+namespace {
+
+    // Inverse transpose of the upper 3x3 (the cofactor matrix over the
+    // determinant), so normals stay perpendicular under non-uniform scale
+    void NormalMatrix(const glm::mat4& m, glm::vec3 (&out)[3]) {
+        // rows of the upper 3x3
+        float a = m[0][0], b = m[1][0], c = m[2][0];
+        float d = m[0][1], e = m[1][1], f = m[2][1];
+        float g = m[0][2], h = m[1][2], k = m[2][2];
+
+        float c00 = e * k - f * h, c01 = f * g - d * k, c02 = d * h - e * g;
+        float c10 = c * h - b * k, c11 = a * k - c * g, c12 = b * g - a * h;
+        float c20 = b * f - c * e, c21 = c * d - a * f, c22 = a * e - b * d;
+        float det = a * c00 + b * c01 + c * c02;
+        float invDet = det != 0.0f ? 1.0f / det : 0.0f;
+
+        out[0] = glm::vec3(c00 * invDet, c10 * invDet, c20 * invDet);
+        out[1] = glm::vec3(c01 * invDet, c11 * invDet, c21 * invDet);
+        out[2] = glm::vec3(c02 * invDet, c12 * invDet, c22 * invDet);
+    }
+
+}  // namespace
 
 RenderSystem::RenderSystem() {
     shaderProgram = compileShader("shaders/vertex.glsl", "shaders/fragment.glsl");
@@ -14,67 +36,72 @@ RenderSystem::RenderSystem() {
         return;
     }
 
-    // Get uniform locations
+    // Get uniform locations; camera and lights come from the FrameData block
     modelLoc = glGetUniformLocation(shaderProgram, "model");
-    viewLoc  = glGetUniformLocation(shaderProgram, "view");
-    projLoc  = glGetUniformLocation(shaderProgram, "projection");
-
-    // Lighting uniforms
-    lightPosLoc = glGetUniformLocation(shaderProgram, "lightPos");
-    lightColorLoc = glGetUniformLocation(shaderProgram, "lightColor");
-    ambientColorLoc = glGetUniformLocation(shaderProgram, "ambientColor");
-    viewLoc = glGetUniformLocation(shaderProgram, "viewPos");
+    textureLoc = glGetUniformLocation(shaderProgram, "texture1");
+    instancedLoc = glGetUniformLocation(shaderProgram, "instanced");
+
+    glGenBuffers(1, &frameUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, frameUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FrameBlockBinding, frameUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    BindFrameBlock(shaderProgram);
+
+    // The sampler always reads unit 0; program state keeps it between draws
+    glUseProgram(shaderProgram);
+    if (textureLoc >= 0) glUniform1i(textureLoc, 0);
+    glUseProgram(0);
 }
 
 
 RenderSystem::~RenderSystem() {
+    if (frameUBO) glDeleteBuffers(1, &frameUBO);
     if (shaderProgram) glDeleteProgram(shaderProgram);
 }
 
 
 
 
-void RenderSystem::RenderEntity(const Entity& e, const TransformComponent& t, const CameraComponent* cam) {
-    if (!shaderProgram || !e.mesh) return;
-    const auto& mesh = e.mesh;
+void RenderSystem::BindFrameBlock(unsigned int program) {
+    GLuint block = glGetUniformBlockIndex(program, "FrameData");
+    if (block == GL_INVALID_INDEX) {
+        std::cerr << "RenderSystem: program " << program << " has no FrameData block\n";
+        return;
+    }
+    glUniformBlockBinding(program, block, FrameBlockBinding);
+}
+
+void RenderSystem::BeginFrame(const CameraComponent* cam) {
+    if (!frameUBO) return;
+
+    FrameUniforms frame;
+    frame.view = cam ? cam->GetView() : glm::mat4(1.0f);
+    frame.projection = cam ? cam->GetProj() : glm::mat4(1.0f);
+    frame.viewPos = glm::vec4(cam ? cam->position : glm::vec3(0.0f), 1.0f);
+    frame.lightPos = glm::vec4(lightPos, 1.0f);
+    frame.lightColor = glm::vec4(lightColor, 1.0f);
+    frame.ambientColor = glm::vec4(ambientColor, 1.0f);
+
+    glBindBuffer(GL_UNIFORM_BUFFER, frameUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &frame);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    stats.cameraUploads++;
+}
+
+void RenderSystem::RenderEntity(const Entity& e, const glm::mat4& model) {
+    const Mesh* mesh = MeshTable::Get(e.mesh);
+    if (!shaderProgram || !mesh) return;
     if (mesh->VAO == 0 || mesh->indexCount == 0) return;
 
     glUseProgram(shaderProgram);
-
-    // Set light and other uniforms (see previous examples)
-    glm::vec3 lightPos(10.0f, 10.0f, 10.0f); 
-    glm::vec3 lightColor(1.0f, 1.0f, 1.0f);
-    glm::vec3 ambientColor(0.1f, 0.1f, 0.1f);
-    glm::vec3 cameraPos = cam ? cam->position : glm::vec3(0.0f);
-
-    // Set uniform variables
-    if (lightPosLoc >= 0) glUniform3fv(lightPosLoc, 1, glm::value_ptr(lightPos));
-    if (lightColorLoc >= 0) glUniform3fv(lightColorLoc, 1, glm::value_ptr(lightColor));
-    if (ambientColorLoc >= 0) glUniform3fv(ambientColorLoc, 1, glm::value_ptr(ambientColor));
-    if (viewLoc >= 0) glUniform3fv(viewLoc, 1, glm::value_ptr(cameraPos));
-
-    // Transformations
-    glm::mat4 model(1.0f);
-    model = glm::translate(model, t.position);
-    model = glm::rotate(model, glm::radians(t.rotation.x), glm::vec3(1, 0, 0));
-    model = glm::rotate(model, glm::radians(t.rotation.y), glm::vec3(0, 1, 0));
-    model = glm::rotate(model, glm::radians(t.rotation.z), glm::vec3(0, 0, 1));
-    model = glm::scale(model, t.scale);
-
-    glm::mat4 view(1.0f), proj(1.0f);
-    if (cam) { view = cam->GetView(); proj = cam->GetProj(); }
-
-    // Set matrices
+    if (instancedLoc >= 0) glUniform1i(instancedLoc, 0);
     if (modelLoc >= 0) glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    if (viewLoc  >= 0) glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    if (projLoc  >= 0) glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(proj));
 
-    // Check for texture component and bind texture
-    auto* textureComponent = ECS::GetComponent<TextureComponent>(e.id);
-    if (textureComponent) {
+    // Bind the entity's texture, if it has one
+    if (e.material != NullMaterial) {
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureComponent->textureID);
-        glUniform1i(glGetUniformLocation(shaderProgram, "texture1"), 0); // Assuming texture1 is the sampler name in shader
+        glBindTexture(GL_TEXTURE_2D, e.material);
     }
 
     // Render the entity
@@ -83,7 +110,139 @@ void RenderSystem::RenderEntity(const Entity& e, const TransformComponent& t, co
     glBindVertexArray(0);
 }
 
+void RenderSystem::Draw(const RenderQueue& queue) {
+    stats = RenderStats();
+    stats.packets = queue.Size();
+    const std::vector<DrawPacket>& packets = queue.Packets();
+    if (!shaderProgram || packets.empty()) return;
+
+    // Instance data goes straight into this frame's region of the stream
+    // buffer; room for every packet, though undrawable ones are skipped
+    std::size_t stallsBefore = instanceStream.Stalls();
+    std::size_t bytes = packets.size() * sizeof(InstanceData);
+    if (!instanceStream.BeginFrame(bytes)) return;
+    StreamBuffer::Allocation allocation = instanceStream.Allocate(bytes, alignof(InstanceData));
+    stats.streamStalls = instanceStream.Stalls() - stallsBefore;
+    if (!allocation.data) {
+        instanceStream.FinishWrites();
+        return;
+    }
+    InstanceData* out = static_cast<InstanceData*>(allocation.data);
+
+    // Split the sorted packets into runs that can share one instanced draw
+    std::uint32_t instanceCount = 0;
+    batches.clear();
+    for (std::size_t i = 0; i < packets.size(); ++i) {
+        const DrawPacket& packet = packets[i];
+        const Mesh* mesh = MeshTable::Get(packet.mesh);
+        if (!mesh || mesh->VAO == 0 || mesh->indexCount == 0 || !packet.model) continue;
+
+        bool sameRun = false;
+        if (!batches.empty()) {
+            const DrawPacket& run = packets[batches.back().packet];
+            sameRun = run.program == packet.program && run.camera == packet.camera &&
+                      run.material == packet.material && run.mesh == packet.mesh;
+        }
+        if (!sameRun) batches.push_back({i, instanceCount, 0});
+        batches.back().count++;
+
+        // Assembled locally and stored whole: the mapping may be write-combined
+        InstanceData instance;
+        instance.model = *packet.model;
+        NormalMatrix(*packet.model, instance.normal);
+        out[instanceCount++] = instance;
+    }
+    instanceStream.FinishWrites();
+    stats.instances = instanceCount;
 
+    unsigned int boundProgram = 0;
+    MaterialHandle boundMaterial = NullMaterial;
+    unsigned int boundVAO = 0;
+    const CameraComponent* boundCamera = nullptr;
+    bool cameraSet = false;
+
+    // Every batch sources its instances from the stream buffer
+    glBindBuffer(GL_ARRAY_BUFFER, instanceStream.Buffer());
+
+    for (const Batch& batch : batches) {
+        const DrawPacket& packet = packets[batch.packet];
+        const Mesh* mesh = MeshTable::Get(packet.mesh);
+
+        if (packet.program != boundProgram) {
+            glUseProgram(packet.program);
+            boundProgram = packet.program;
+            stats.programBinds++;
+
+            if (instancedLoc >= 0) glUniform1i(instancedLoc, 1);
+        }
+
+        // Shared by every program through the FrameData block, so only a
+        // different camera needs a new upload
+        if (!cameraSet || packet.camera != boundCamera) {
+            BeginFrame(packet.camera);
+            boundCamera = packet.camera;
+            cameraSet = true;
+        }
+
+        // Untextured packets leave the last texture bound, as RenderEntity() does
+        if (packet.material != NullMaterial && packet.material != boundMaterial) {
+            if (boundMaterial == NullMaterial) glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, packet.material);
+            boundMaterial = packet.material;
+            stats.textureBinds++;
+        }
+
+        if (mesh->VAO != boundVAO) {
+            if (boundVAO) DisableInstanceAttributes();
+            glBindVertexArray(mesh->VAO);
+            boundVAO = mesh->VAO;
+            stats.vertexArrayBinds++;
+        }
+
+        BindInstanceAttributes(allocation.offset + std::size_t(batch.first) * sizeof(InstanceData));
+        glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(mesh->indexCount), GL_UNSIGNED_INT, 0,
+                                static_cast<GLsizei>(batch.count));
+        stats.drawCalls++;
+    }
+
+    if (boundVAO) DisableInstanceAttributes();
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    instanceStream.EndFrame();
+}
+
+// Points the bound VAO's instance attributes at the run starting `base`
+// bytes into the stream buffer; GL 3.3 has no base instance, so the offset
+// goes here
+void RenderSystem::BindInstanceAttributes(std::size_t base) {
+    const GLsizei stride = sizeof(InstanceData);
+
+    for (GLuint column = 0; column < 4; ++column) {
+        GLuint attrib = InstanceModelAttrib + column;
+        glEnableVertexAttribArray(attrib);
+        glVertexAttribPointer(attrib, 4, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(base + offsetof(InstanceData, model) + column * sizeof(glm::vec4)));
+        glVertexAttribDivisor(attrib, 1);
+    }
+    for (GLuint column = 0; column < 3; ++column) {
+        GLuint attrib = InstanceNormalAttrib + column;
+        glEnableVertexAttribArray(attrib);
+        glVertexAttribPointer(attrib, 3, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(base + offsetof(InstanceData, normal) + column * sizeof(glm::vec3)));
+        glVertexAttribDivisor(attrib, 1);
+    }
+}
+
+// Mesh VAOs are shared with RenderEntity() and other programs, so they must
+// not keep per-instance arrays pointing into the stream buffer
+void RenderSystem::DisableInstanceAttributes() {
+    for (GLuint attrib = InstanceModelAttrib; attrib < InstanceModelAttrib + 4; ++attrib) {
+        glDisableVertexAttribArray(attrib);
+    }
+    for (GLuint attrib = InstanceNormalAttrib; attrib < InstanceNormalAttrib + 3; ++attrib) {
+        glDisableVertexAttribArray(attrib);
+    }
+}
 
 unsigned int RenderSystem::compileShader(const char* vertexPath, const char* fragmentPath) {
     auto compileSrc = [](GLenum type, const char* src)->GLuint {
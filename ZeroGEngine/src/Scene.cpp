@@ -1,26 +1,78 @@
 #include "Scene.hpp"
 #include "ECS.hpp"
+#include "View.hpp"
 
 
-Scene::Scene() {
+Scene::Scene() : Scene(ECS::CurrentWorld()) {}
+
+Scene::Scene(World& w) : world(w), hierarchy(w) {
     // top-right camera by default
     sceneCamera.position = {1.5f, 1.5f, 1.5f};
     sceneCamera.front = {-1.f, -1.f, -1.f};
     sceneCamera.up = {0.f, 1.f, 0.f};
     sceneCamera.aspect = 800.f / 600.f;
+    sceneCamera.Refresh();
 
 
 
 }
 
-void Scene::Render() {
-    const auto& ents = ECS::GetAllEntities();
-    for (const auto& kv : ents) {
-        const Entity& e = kv.second;
-        auto t = ECS::GetTransform(e.id);
-        if (!t) continue;
-        CameraComponent* cam = nullptr;
-        if (ECS::HasCamera(e.id)) cam = ECS::GetCamera(e.id);
-        renderer.RenderEntity(e, *t, cam ? cam : &sceneCamera);
+void Scene::Render(JobSystem* jobs) {
+    ECS::WorldScope scope(world);
+
+    // Only transforms that changed since last frame (and their children) are recomputed
+    hierarchy.Update(jobs);
+
+    // Gather every drawable entity with its world-space bounds, drop the ones
+    // outside the view frustum, then draw the rest grouped by state.
+    // Read-only, so drawing never marks components as changed
+    queue.Clear();
+    candidates.clear();
+    bounds.Clear();
+    cullStats = CullStats();
+
+    std::size_t count = world.Storage<TransformComponent>().Size();
+    candidates.reserve(count);
+    bounds.Reserve(count);
+
+    ECS::View<const Entity, const TransformComponent> view(world);
+    view.Each([this](EntityID id, const Entity& e, const TransformComponent&) {
+        const Mesh* mesh = MeshTable::Get(e.mesh);
+        if (!mesh) return;
+        const glm::mat4* model = hierarchy.WorldMatrix(id);
+        if (!model) return;
+        cullStats.total++;
+
+        glm::vec3 center, extent;
+        TransformBounds(*model, mesh->boundsMin, mesh->boundsMax, center, extent);
+
+        // An entity with its own camera is drawn (and culled) with that one
+        if (const CameraComponent* cam = world.Read<CameraComponent>(id)) {
+            if (Frustum::FromMatrix(cam->GetProj() * cam->GetView()).Intersects(center, extent)) {
+                cullStats.visible++;
+                PushPacket({model, e.material, e.mesh}, *cam);
+            }
+            return;
+        }
+        candidates.push_back({model, e.material, e.mesh});
+        bounds.Push(center, extent);
+    });
+
+    visible.resize(bounds.Size());
+    Frustum frustum = Frustum::FromMatrix(sceneCamera.GetProj() * sceneCamera.GetView());
+    cullStats.visible += CullBoxes(frustum, bounds, visible.data());
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        if (visible[i]) PushPacket(candidates[i], sceneCamera);
     }
+
+    queue.Sort();
+    renderer.Draw(queue);
+}
+
+void Scene::PushPacket(const Candidate& candidate, const CameraComponent& cam) {
+    const glm::vec4& origin = (*candidate.model)[3];
+    glm::vec3 offset = glm::vec3(origin.x, origin.y, origin.z) - cam.position;
+    float depth = glm::dot(offset, glm::normalize(cam.front));
+    queue.Push(RenderPass::Opaque, renderer.shaderProgram, candidate.material, candidate.mesh, depth,
+               candidate.model, &cam);
 }
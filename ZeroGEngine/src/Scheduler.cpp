@@ -0,0 +1,92 @@
+#include "Scheduler.hpp"
+
+#include <algorithm>
+
+static bool Overlaps(const std::vector<ComponentTypeID>& a, const std::vector<ComponentTypeID>& b) {
+    for (ComponentTypeID t : a) {
+        if (std::find(b.begin(), b.end(), t) != b.end()) return true;
+    }
+    return false;
+}
+
+Scheduler::SystemBuilder& Scheduler::SystemBuilder::OnMainThread() {
+    scheduler.systems[index].mainThread = true;
+    return *this;
+}
+
+void Scheduler::SystemBuilder::Declare(ComponentTypeID type, bool write) {
+    auto& list = write ? scheduler.systems[index].writes : scheduler.systems[index].reads;
+    if (std::find(list.begin(), list.end(), type) == list.end()) list.push_back(type);
+    scheduler.stagesDirty = true;
+}
+
+Scheduler::Scheduler(JobSystem& jobs_) : jobs(jobs_) {}
+
+Scheduler::SystemBuilder Scheduler::AddSystem(const std::string& name, SystemFn fn) {
+    systems.push_back(System{name, std::move(fn), {}, {}, false});
+    stagesDirty = true;
+    return SystemBuilder(*this, systems.size() - 1);
+}
+
+bool Scheduler::Conflicts(const System& a, const System& b) {
+    return Overlaps(a.writes, b.writes) || Overlaps(a.writes, b.reads) || Overlaps(a.reads, b.writes);
+}
+
+// A system lands one stage after the latest earlier system it conflicts with,
+// so declared order is preserved only where it matters.
+void Scheduler::BuildStages() {
+    stages.clear();
+    std::vector<std::size_t> stageOf(systems.size(), 0);
+    for (std::size_t i = 0; i < systems.size(); ++i) {
+        std::size_t stage = 0;
+        for (std::size_t j = 0; j < i; ++j) {
+            if (Conflicts(systems[i], systems[j])) stage = std::max(stage, stageOf[j] + 1);
+        }
+        stageOf[i] = stage;
+        if (stages.size() <= stage) stages.resize(stage + 1);
+        stages[stage].push_back(i);
+    }
+    stagesDirty = false;
+}
+
+const std::vector<std::vector<std::size_t>>& Scheduler::Stages() {
+    if (stagesDirty) BuildStages();
+    return stages;
+}
+
+void Scheduler::PrintStages(std::ostream& out) {
+    const auto& s = Stages();
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        out << "Stage " << i << ":";
+        for (std::size_t index : s[i]) {
+            out << " " << systems[index].name << (systems[index].mainThread ? " (main)" : "");
+        }
+        out << "\n";
+    }
+}
+
+void Scheduler::Run(float dt) {
+    // Jobs run on workers whose current world is their own thread's default,
+    // so bind the caller's world inside each one
+    World* world = &ECS::CurrentWorld();
+    for (const auto& stage : Stages()) {
+        if (stage.size() == 1) {
+            systems[stage[0]].fn(dt);
+            continue;
+        }
+
+        JobSystem::JobCounter counter;
+        for (std::size_t index : stage) {
+            if (systems[index].mainThread) continue;
+            SystemFn* fn = &systems[index].fn;
+            jobs.Submit([fn, dt, world] {
+                ECS::WorldScope scope(*world);
+                (*fn)(dt);
+            }, counter);
+        }
+        for (std::size_t index : stage) {
+            if (systems[index].mainThread) systems[index].fn(dt);
+        }
+        jobs.Wait(counter);
+    }
+}
@@ -0,0 +1,169 @@
+#include "SpatialSort.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+    constexpr unsigned MortonBits = 10;
+    constexpr unsigned RadixBits = 10; // one pass per Morton axis width
+    constexpr unsigned RadixPasses = 3;
+    constexpr std::size_t Buckets = std::size_t(1) << RadixBits;
+
+    // Spreads the low 10 bits of v so there are two zero bits between each
+    std::uint32_t SpreadBits(std::uint32_t v) {
+        v &= 0x3ff;
+        v = (v | (v << 16)) & 0x030000ff;
+        v = (v | (v << 8)) & 0x0300f00f;
+        v = (v | (v << 4)) & 0x030c30c3;
+        v = (v | (v << 2)) & 0x09249249;
+        return v;
+    }
+
+    std::uint32_t Quantize(float value, float min, float scale) {
+        float cell = (value - min) * scale;
+        return cell <= 0.0f ? 0u : std::min(static_cast<std::uint32_t>(cell), (1u << MortonBits) - 1);
+    }
+
+    std::size_t Bucket(std::uint64_t key, unsigned radixPass) {
+        return (key >> (32 + radixPass * RadixBits)) & (Buckets - 1);
+    }
+
+}  // namespace
+
+SpatialSort::SpatialSort(World& world_) : world(world_) {
+    pools.push_back({&world.Storage<TransformComponent>(), 0});
+}
+
+std::uint32_t SpatialSort::MortonCode(std::uint32_t x, std::uint32_t y, std::uint32_t z) {
+    return SpreadBits(x) | (SpreadBits(y) << 1) | (SpreadBits(z) << 2);
+}
+
+void SpatialSort::BeginPass() {
+    order = world.Storage<TransformComponent>().Entities();
+    keys.clear();
+    keys.reserve(order.size());
+    boundsMin = glm::vec3(std::numeric_limits<float>::max());
+    boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+    cursor = 0;
+}
+
+void SpatialSort::Step(std::size_t budget) {
+    auto& transforms = world.Storage<TransformComponent>();
+
+    while (budget > 0) {
+        switch (phase) {
+        case Phase::Bounds: {
+            if (cursor == 0) BeginPass();
+            std::size_t end = std::min(order.size(), cursor + budget);
+            budget -= end - cursor;
+            for (; cursor < end; ++cursor) {
+                if (const TransformComponent* t = transforms.Read(order[cursor])) {
+                    boundsMin = glm::min(boundsMin, t->position);
+                    boundsMax = glm::max(boundsMax, t->position);
+                }
+            }
+            if (cursor == order.size()) {
+                phase = Phase::Keys;
+                cursor = 0;
+            }
+            break;
+        }
+        case Phase::Keys: {
+            glm::vec3 extent = glm::max(boundsMax - boundsMin, glm::vec3(1e-6f));
+            const float cells = float(1u << MortonBits);
+            glm::vec3 scale(cells / extent.x, cells / extent.y, cells / extent.z);
+            std::size_t end = std::min(order.size(), cursor + budget);
+            budget -= end - cursor;
+            for (; cursor < end; ++cursor) {
+                // Entities that lost their transform since the snapshot get
+                // no key, so they drop out of the pass
+                const TransformComponent* t = transforms.Read(order[cursor]);
+                if (!t) continue;
+                std::uint32_t code = MortonCode(Quantize(t->position.x, boundsMin.x, scale.x),
+                                                Quantize(t->position.y, boundsMin.y, scale.y),
+                                                Quantize(t->position.z, boundsMin.z, scale.z));
+                keys.push_back(std::uint64_t(code) << 32 | cursor);
+            }
+            if (cursor == order.size()) {
+                phase = Phase::Count;
+                radixPass = 0;
+                cursor = 0;
+            }
+            break;
+        }
+        case Phase::Count: {
+            // Histogram for one stable LSD radix pass over the Morton bits
+            if (cursor == 0) counts.assign(Buckets + 1, 0);
+            std::size_t end = std::min(keys.size(), cursor + budget);
+            budget -= end - cursor;
+            for (; cursor < end; ++cursor) counts[Bucket(keys[cursor], radixPass) + 1]++;
+            if (cursor == keys.size()) {
+                for (std::size_t b = 1; b <= Buckets; ++b) counts[b] += counts[b - 1];
+                if (radixPass + 1 < RadixPasses) scratch.resize(keys.size());
+                else sorted.resize(keys.size());
+                phase = Phase::Scatter;
+                cursor = 0;
+            }
+            break;
+        }
+        case Phase::Scatter: {
+            // The last pass scatters entities instead of keys, which yields
+            // the sorted order directly
+            bool last = radixPass + 1 == RadixPasses;
+            std::size_t end = std::min(keys.size(), cursor + budget);
+            budget -= end - cursor;
+            if (last) {
+                for (; cursor < end; ++cursor) {
+                    std::uint64_t key = keys[cursor];
+                    sorted[counts[Bucket(key, radixPass)]++] = order[key & UINT32_MAX];
+                }
+            } else {
+                for (; cursor < end; ++cursor) {
+                    std::uint64_t key = keys[cursor];
+                    scratch[counts[Bucket(key, radixPass)]++] = key;
+                }
+            }
+            if (cursor < keys.size()) break;
+
+            cursor = 0;
+            if (!last) {
+                keys.swap(scratch);
+                radixPass++;
+                phase = Phase::Count;
+                break;
+            }
+            order.swap(sorted);
+            for (SortedPool& sortedPool : pools) sortedPool.placed = 0;
+            phase = Phase::Apply;
+            break;
+        }
+        case Phase::Apply: {
+            std::size_t end = std::min(order.size(), cursor + budget);
+            budget -= end - cursor;
+            for (; cursor < end; ++cursor) {
+                EntityID id = order[cursor];
+                for (SortedPool& sortedPool : pools) {
+                    // Slots below `placed` are done; an entity moved there by
+                    // a removal since the pass began just stays where it is
+                    std::uint32_t slot = sortedPool.pool->Slot(id);
+                    if (slot == UINT32_MAX || slot < sortedPool.placed) continue;
+                    sortedPool.pool->SwapSlots(static_cast<std::uint32_t>(sortedPool.placed++), slot);
+                }
+            }
+            if (cursor == order.size()) {
+                phase = Phase::Bounds;
+                cursor = 0;
+                passes++;
+                return;
+            }
+            break;
+        }
+        }
+    }
+}
+
+void SpatialSort::SortNow() {
+    std::size_t pass = passes;
+    while (passes == pass) Step(SIZE_MAX / 2);
+}
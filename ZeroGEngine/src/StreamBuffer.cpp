@@ -0,0 +1,124 @@
+#include "StreamBuffer.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+    constexpr GLuint64 OneMillisecond = 1000000;
+
+}  // namespace
+
+StreamBuffer::StreamBuffer(GLenum target_, std::size_t regionSize_)
+    : target(target_),
+      persistent(GLAD_GL_ARB_buffer_storage && glad_glBufferStorage),
+      regionSize(regionSize_) {}
+
+StreamBuffer::~StreamBuffer() {
+    Destroy();
+}
+
+void StreamBuffer::Create() {
+    glGenBuffers(1, &buffer);
+    glBindBuffer(target, buffer);
+
+    if (persistent) {
+        // Coherent, so writes need no explicit flush before the draw
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(target, regionSize * Regions, nullptr, flags);
+        mapped = static_cast<std::uint8_t*>(glMapBufferRange(target, 0, regionSize * Regions, flags));
+        if (!mapped) {
+            std::cerr << "StreamBuffer: persistent mapping failed, falling back to orphaning\n";
+            glDeleteBuffers(1, &buffer);
+            persistent = false;
+            Create();
+        }
+    } else {
+        glBufferData(target, regionSize, nullptr, GL_STREAM_DRAW);
+    }
+}
+
+// No fence waits: GL keeps a deleted buffer alive until the commands still
+// reading it are done, and the CPU stops writing once it is unmapped
+void StreamBuffer::Destroy() {
+    for (unsigned i = 0; i < Regions; ++i) {
+        if (fences[i]) {
+            glDeleteSync(fences[i]);
+            fences[i] = nullptr;
+        }
+    }
+    if (buffer) {
+        if (mapped) {
+            glBindBuffer(target, buffer);
+            glUnmapBuffer(target);
+            mapped = nullptr;
+        }
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+}
+
+// True if the GPU had not finished with the region yet
+bool StreamBuffer::WaitFence(unsigned index) {
+    GLenum status = glClientWaitSync(fences[index], GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) return false;
+
+    while (status == GL_TIMEOUT_EXPIRED) {
+        status = glClientWaitSync(fences[index], GL_SYNC_FLUSH_COMMANDS_BIT, OneMillisecond);
+    }
+    if (status == GL_WAIT_FAILED) std::cerr << "StreamBuffer: waiting on a fence failed\n";
+    return true;
+}
+
+bool StreamBuffer::BeginFrame(std::size_t bytes) {
+    if (bytes > regionSize) {
+        // Regions are fixed in the persistent layout; rebuild everything bigger
+        Destroy();
+        regionSize = std::max(bytes, regionSize + regionSize / 2);
+        region = Regions - 1;
+    }
+    if (!buffer) Create();
+
+    region = (region + 1) % Regions;
+    used = 0;
+
+    if (persistent) {
+        if (fences[region]) {
+            if (WaitFence(region)) stalls++;
+            glDeleteSync(fences[region]);
+            fences[region] = nullptr;
+        }
+        glBindBuffer(target, buffer);
+        return true;
+    }
+
+    // Orphan: the driver hands out fresh storage while the GPU keeps reading
+    // the old one, then map the whole (single) region
+    glBindBuffer(target, buffer);
+    glBufferData(target, regionSize, nullptr, GL_STREAM_DRAW);
+    mapped = static_cast<std::uint8_t*>(
+        glMapBufferRange(target, 0, regionSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    if (!mapped) std::cerr << "StreamBuffer: mapping failed\n";
+    return mapped != nullptr;
+}
+
+StreamBuffer::Allocation StreamBuffer::Allocate(std::size_t size, std::size_t alignment) {
+    std::size_t start = (used + alignment - 1) / alignment * alignment;
+    if (!mapped || start + size > regionSize) return {};
+
+    used = start + size;
+    std::size_t base = persistent ? std::size_t(region) * regionSize : 0;
+    return {mapped + base + start, base + start};
+}
+
+void StreamBuffer::FinishWrites() {
+    if (persistent || !mapped) return;
+    glBindBuffer(target, buffer);
+    if (!glUnmapBuffer(target)) std::cerr << "StreamBuffer: buffer contents lost while mapped\n";
+    mapped = nullptr;
+}
+
+void StreamBuffer::EndFrame() {
+    if (!persistent || !buffer) return;
+    fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
@@ -0,0 +1,56 @@
+#include "TagTable.hpp"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace {
+
+    struct Table {
+        std::shared_mutex mutex;
+        std::deque<std::string> names{std::string()}; // deque: references stay valid
+        std::unordered_map<std::string_view, TagID> ids;
+    };
+
+    Table& GetTable() {
+        static Table table;
+        return table;
+    }
+
+}  // namespace
+
+TagID TagTable::Intern(std::string_view name) {
+    if (name.empty()) return NoTag;
+
+    Table& table = GetTable();
+    {
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        auto found = table.ids.find(name);
+        if (found != table.ids.end()) return found->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(table.mutex);
+    auto found = table.ids.find(name);
+    if (found != table.ids.end()) return found->second;
+
+    TagID tag = static_cast<TagID>(table.names.size());
+    table.names.emplace_back(name);
+    table.ids.emplace(table.names.back(), tag);
+    return tag;
+}
+
+TagID TagTable::Find(std::string_view name) {
+    if (name.empty()) return NoTag;
+
+    Table& table = GetTable();
+    std::shared_lock<std::shared_mutex> lock(table.mutex);
+    auto found = table.ids.find(name);
+    return found != table.ids.end() ? found->second : NoTag;
+}
+
+const std::string& TagTable::Name(TagID tag) {
+    Table& table = GetTable();
+    std::shared_lock<std::shared_mutex> lock(table.mutex);
+    return tag < table.names.size() ? table.names[tag] : table.names[NoTag];
+}
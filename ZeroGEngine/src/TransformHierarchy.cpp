@@ -0,0 +1,171 @@
+#include "TransformHierarchy.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+TransformHierarchy::TransformHierarchy(World& world_) : world(world_) {}
+
+void TransformHierarchy::Update(JobSystem* jobs) {
+    const auto& transforms = world.Storage<TransformComponent>();
+    bool all = StructureChanged();
+    if (all) {
+        Rebuild();
+        ComposeLocals(transforms, jobs);
+    }
+
+    // Depth levels run in order; the nodes within one level don't depend on
+    // each other, so a level can be split across workers
+    std::atomic<std::size_t> updated{0};
+    for (std::size_t depth = 0; depth + 1 < levelStarts.size(); ++depth) {
+        std::size_t begin = levelStarts[depth];
+        std::size_t end = levelStarts[depth + 1];
+        if (jobs && jobs->WorkerCount() > 0 && end - begin > ParallelGrain) {
+            jobs->ParallelFor(end - begin, ParallelGrain, [&](std::size_t b, std::size_t e) {
+                updated += UpdateRange(transforms, begin + b, begin + e, all);
+            });
+        } else {
+            updated += UpdateRange(transforms, begin, end, all);
+        }
+    }
+
+    lastUpdated = updated;
+    lastTick = world.CurrentTick();
+}
+
+// Local matrices of every node, written straight into worldMatrices
+void TransformHierarchy::ComposeLocals(const ComponentPool<TransformComponent>& transforms, JobSystem* jobs) {
+    soa.Gather(transforms, ids);
+    if (jobs && jobs->WorkerCount() > 0 && ids.size() > ParallelGrain) {
+        jobs->ParallelFor(ids.size(), ParallelGrain, [&](std::size_t begin, std::size_t end) {
+            ComposeModelMatrices(soa, worldMatrices.data(), begin, end);
+        });
+    } else {
+        ComposeModelMatrices(soa, worldMatrices.data());
+    }
+}
+
+std::size_t TransformHierarchy::UpdateRange(const ComponentPool<TransformComponent>& transforms,
+                                            std::size_t begin, std::size_t end, bool all) {
+    std::size_t updated = 0;
+    for (std::size_t node = begin; node < end; ++node) {
+        std::uint32_t parent = parents[node];
+        if (all) {
+            // Local matrix already composed by ComposeLocals()
+            if (parent != NoNode) worldMatrices[node] = worldMatrices[parent] * worldMatrices[node];
+            dirty[node] = 1;
+            ++updated;
+            continue;
+        }
+
+        bool changed = (parent != NoNode && dirty[parent]) ||
+                       TickAtOrAfter(transforms.ChangedTick(ids[node]), lastTick);
+        dirty[node] = changed;
+        if (!changed) continue;
+
+        glm::mat4 local = LocalMatrix(*transforms.Read(ids[node]));
+        worldMatrices[node] = parent != NoNode ? worldMatrices[parent] * local : local;
+        ++updated;
+    }
+    return updated;
+}
+
+bool TransformHierarchy::StructureChanged() const {
+    if (!built) return true;
+
+    auto& transforms = world.Storage<TransformComponent>();
+    auto& links = world.Storage<HierarchyComponent>();
+    if (transforms.Size() != transformCount || links.Size() != hierarchyCount) return true;
+
+    // New transforms, or links that were added or written to
+    for (std::uint32_t tick : transforms.AddedTicks()) {
+        if (TickAtOrAfter(tick, lastTick)) return true;
+    }
+    for (std::uint32_t tick : links.ChangedTicks()) {
+        if (TickAtOrAfter(tick, lastTick)) return true;
+    }
+    return false;
+}
+
+void TransformHierarchy::Rebuild() {
+    auto& transforms = world.Storage<TransformComponent>();
+    auto& links = world.Storage<HierarchyComponent>();
+    const std::vector<EntityID>& entities = transforms.Entities();
+    const std::uint32_t count = static_cast<std::uint32_t>(entities.size());
+
+    // Entity index -> position in the (unsorted) transform pool
+    std::fill(nodeOf.begin(), nodeOf.end(), NoNode);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::uint32_t index = EntityIndex(entities[i]);
+        if (index >= nodeOf.size()) nodeOf.resize(index + 1, NoNode);
+        nodeOf[index] = i;
+    }
+
+    // Parent links that point at a live entity with a transform
+    std::vector<std::uint32_t> parentOf(count, NoNode);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const HierarchyComponent* link = links.Read(entities[i]);
+        if (!link || link->parent == entities[i]) continue;
+
+        std::uint32_t index = EntityIndex(link->parent);
+        if (index < nodeOf.size() && nodeOf[index] != NoNode && entities[nodeOf[index]] == link->parent) {
+            parentOf[i] = nodeOf[index];
+        }
+    }
+
+    // Depth of every node, walking up to the nearest node with a known depth.
+    // A cycle (only possible by writing links directly) is cut where it closes.
+    constexpr std::uint32_t Visiting = NoNode - 1;
+    std::vector<std::uint32_t> depths(count, NoNode);
+    std::vector<std::uint32_t> chain;
+    std::uint32_t maxDepth = 0;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (depths[i] != NoNode) continue;
+
+        chain.clear();
+        std::uint32_t node = i;
+        while (node != NoNode && depths[node] == NoNode) {
+            depths[node] = Visiting;
+            chain.push_back(node);
+            node = parentOf[node];
+        }
+
+        std::uint32_t depth = 0;
+        if (node != NoNode) {
+            if (depths[node] == Visiting) {
+                parentOf[chain.back()] = NoNode;
+            } else {
+                depth = depths[node] + 1;
+            }
+        }
+        for (std::size_t k = chain.size(); k-- > 0; ++depth) {
+            depths[chain[k]] = depth;
+        }
+        maxDepth = std::max(maxDepth, depth - 1);
+    }
+
+    // Counting sort by depth
+    levelStarts.assign(count > 0 ? maxDepth + 2 : 0, 0);
+    for (std::uint32_t i = 0; i < count; ++i) levelStarts[depths[i] + 1]++;
+    for (std::size_t d = 1; d < levelStarts.size(); ++d) levelStarts[d] += levelStarts[d - 1];
+
+    std::vector<std::uint32_t> sorted(count);
+    std::vector<std::size_t> next(levelStarts.begin(), levelStarts.end());
+    for (std::uint32_t i = 0; i < count; ++i) {
+        sorted[i] = static_cast<std::uint32_t>(next[depths[i]]++);
+    }
+
+    ids.resize(count);
+    parents.resize(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::uint32_t node = sorted[i];
+        ids[node] = entities[i];
+        parents[node] = parentOf[i] != NoNode ? sorted[parentOf[i]] : NoNode;
+        nodeOf[EntityIndex(entities[i])] = node;
+    }
+    worldMatrices.resize(count);
+    dirty.assign(count, 1);
+
+    transformCount = transforms.Size();
+    hierarchyCount = links.Size();
+    built = true;
+}
@@ -0,0 +1,300 @@
+#include "TransformSoA.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ZEROG_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// ---------- SoA storage ----------
+
+void TransformSoA::Resize(std::size_t n) {
+    count = n;
+    std::size_t padded = (n + Lanes - 1) / Lanes * Lanes;
+    for (auto* a : {&px, &py, &pz, &rx, &ry, &rz}) a->assign(padded, 0.0f);
+    for (auto* a : {&sx, &sy, &sz}) a->assign(padded, 1.0f);
+}
+
+void TransformSoA::Set(std::size_t i, const TransformComponent& t) {
+    px[i] = t.position.x; py[i] = t.position.y; pz[i] = t.position.z;
+    rx[i] = t.rotation.x; ry[i] = t.rotation.y; rz[i] = t.rotation.z;
+    sx[i] = t.scale.x;    sy[i] = t.scale.y;    sz[i] = t.scale.z;
+}
+
+void TransformSoA::Gather(const ComponentPool<TransformComponent>& pool) {
+    const auto& transforms = pool.Components();
+    Resize(transforms.size());
+    for (std::size_t i = 0; i < transforms.size(); ++i) Set(i, transforms[i]);
+}
+
+void TransformSoA::Gather(const ComponentPool<TransformComponent>& pool, const std::vector<EntityID>& ids) {
+    Resize(ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        if (const TransformComponent* t = pool.Read(ids[i])) Set(i, *t);
+    }
+}
+
+// ---------- Kernels ----------
+//
+// M = T * Rx(a) * Ry(b) * Rz(c) * S, column-major like glm:
+//   col0 = sx * ( cb*cc,            sa*sb*cc + ca*sc,  -ca*sb*cc + sa*sc, 0)
+//   col1 = sy * (-cb*sc,           -sa*sb*sc + ca*cc,   ca*sb*sc + sa*cc, 0)
+//   col2 = sz * ( sb,              -sa*cb,              ca*cb,            0)
+//   col3 =      ( px,               py,                 pz,               1)
+
+namespace {
+
+    constexpr float DegToRad = 3.14159265358979f / 180.0f;
+
+    void ComposeScalar(const TransformSoA& soa, glm::mat4* out, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            float sa = std::sin(soa.rx[i] * DegToRad), ca = std::cos(soa.rx[i] * DegToRad);
+            float sb = std::sin(soa.ry[i] * DegToRad), cb = std::cos(soa.ry[i] * DegToRad);
+            float sc = std::sin(soa.rz[i] * DegToRad), cc = std::cos(soa.rz[i] * DegToRad);
+
+            float m[16] = {
+                soa.sx[i] * (cb * cc), soa.sx[i] * (sa * sb * cc + ca * sc), soa.sx[i] * (sa * sc - ca * sb * cc), 0.0f,
+                soa.sy[i] * -(cb * sc), soa.sy[i] * (ca * cc - sa * sb * sc), soa.sy[i] * (ca * sb * sc + sa * cc), 0.0f,
+                soa.sz[i] * sb, soa.sz[i] * -(sa * cb), soa.sz[i] * (ca * cb), 0.0f,
+                soa.px[i], soa.py[i], soa.pz[i], 1.0f,
+            };
+            std::memcpy(&out[i], m, sizeof(m));
+        }
+    }
+
+#ifdef ZEROG_X86_SIMD
+
+    // sin/cos of radians via Cody-Waite reduction to [-pi/4, pi/4] and the
+    // Cephes minimax polynomials (~1e-7 error over game-sized angles)
+    constexpr float PiOver2Hi = 1.5707963705062866f;
+    constexpr float PiOver2Lo = -4.3711388286737929e-08f;
+    constexpr float TwoOverPi = 0.63661977236758134f;
+    constexpr float S1 = -1.6666654611e-1f, S2 = 8.3321608736e-3f, S3 = -1.9515295891e-4f;
+    constexpr float C1 = 4.166664568298827e-2f, C2 = -1.388731625493765e-3f, C3 = 2.443315711809948e-5f;
+
+    // ---- SSE2: 4 lanes ----
+
+    __attribute__((target("sse2")))
+    inline __m128 Select128(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    __attribute__((target("sse2")))
+    inline void SinCos128(__m128 x, __m128& s, __m128& c) {
+        __m128i q = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(TwoOverPi)));
+        __m128 qf = _mm_cvtepi32_ps(q);
+        __m128 r = _mm_sub_ps(x, _mm_mul_ps(qf, _mm_set1_ps(PiOver2Hi)));
+        r = _mm_sub_ps(r, _mm_mul_ps(qf, _mm_set1_ps(PiOver2Lo)));
+
+        __m128 r2 = _mm_mul_ps(r, r);
+        __m128 ps = _mm_add_ps(_mm_set1_ps(S2), _mm_mul_ps(r2, _mm_set1_ps(S3)));
+        ps = _mm_add_ps(_mm_set1_ps(S1), _mm_mul_ps(r2, ps));
+        ps = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r2, r), ps));
+        __m128 pc = _mm_add_ps(_mm_set1_ps(C2), _mm_mul_ps(r2, _mm_set1_ps(C3)));
+        pc = _mm_add_ps(_mm_set1_ps(C1), _mm_mul_ps(r2, pc));
+        pc = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(r2, _mm_set1_ps(0.5f))),
+                        _mm_mul_ps(_mm_mul_ps(r2, r2), pc));
+
+        // Odd quadrants swap sin and cos; sin flips sign in quadrants 2-3, cos in 1-2
+        __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+        __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, _mm_set1_epi32(2)), 30));
+        __m128 cosSign = _mm_castsi128_ps(
+            _mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+        s = _mm_xor_ps(Select128(swap, pc, ps), sinSign);
+        c = _mm_xor_ps(Select128(swap, ps, pc), cosSign);
+    }
+
+    __attribute__((target("sse2")))
+    void ComposeSSE2(const TransformSoA& soa, glm::mat4* out, std::size_t begin, std::size_t end) {
+        const __m128 toRad = _mm_set1_ps(DegToRad);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        std::size_t i = begin;
+        for (; i + 4 <= end; i += 4) {
+            __m128 sa, ca, sb, cb, sc, cc;
+            SinCos128(_mm_mul_ps(_mm_loadu_ps(&soa.rx[i]), toRad), sa, ca);
+            SinCos128(_mm_mul_ps(_mm_loadu_ps(&soa.ry[i]), toRad), sb, cb);
+            SinCos128(_mm_mul_ps(_mm_loadu_ps(&soa.rz[i]), toRad), sc, cc);
+            __m128 sx = _mm_loadu_ps(&soa.sx[i]), sy = _mm_loadu_ps(&soa.sy[i]), sz = _mm_loadu_ps(&soa.sz[i]);
+
+            __m128 sasb = _mm_mul_ps(sa, sb), casb = _mm_mul_ps(ca, sb);
+            __m128 e[16] = {
+                _mm_mul_ps(sx, _mm_mul_ps(cb, cc)),
+                _mm_mul_ps(sx, _mm_add_ps(_mm_mul_ps(sasb, cc), _mm_mul_ps(ca, sc))),
+                _mm_mul_ps(sx, _mm_sub_ps(_mm_mul_ps(sa, sc), _mm_mul_ps(casb, cc))),
+                zero,
+                _mm_mul_ps(sy, _mm_sub_ps(zero, _mm_mul_ps(cb, sc))),
+                _mm_mul_ps(sy, _mm_sub_ps(_mm_mul_ps(ca, cc), _mm_mul_ps(sasb, sc))),
+                _mm_mul_ps(sy, _mm_add_ps(_mm_mul_ps(casb, sc), _mm_mul_ps(sa, cc))),
+                zero,
+                _mm_mul_ps(sz, sb),
+                _mm_mul_ps(sz, _mm_sub_ps(zero, _mm_mul_ps(sa, cb))),
+                _mm_mul_ps(sz, _mm_mul_ps(ca, cb)),
+                zero,
+                _mm_loadu_ps(&soa.px[i]), _mm_loadu_ps(&soa.py[i]), _mm_loadu_ps(&soa.pz[i]), one,
+            };
+
+            // e[k] holds element k of 4 matrices; transpose each column into place
+            float* dst = reinterpret_cast<float*>(&out[i]);
+            for (int col = 0; col < 4; ++col) {
+                __m128 r0 = e[col * 4 + 0], r1 = e[col * 4 + 1], r2 = e[col * 4 + 2], r3 = e[col * 4 + 3];
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                _mm_storeu_ps(dst + 0 * 16 + col * 4, r0);
+                _mm_storeu_ps(dst + 1 * 16 + col * 4, r1);
+                _mm_storeu_ps(dst + 2 * 16 + col * 4, r2);
+                _mm_storeu_ps(dst + 3 * 16 + col * 4, r3);
+            }
+        }
+        ComposeScalar(soa, out, i, end);
+    }
+
+    // ---- AVX2: 8 lanes ----
+
+    __attribute__((target("avx2")))
+    inline void SinCos256(__m256 x, __m256& s, __m256& c) {
+        __m256i q = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(TwoOverPi)));
+        __m256 qf = _mm256_cvtepi32_ps(q);
+        __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(qf, _mm256_set1_ps(PiOver2Hi)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(qf, _mm256_set1_ps(PiOver2Lo)));
+
+        __m256 r2 = _mm256_mul_ps(r, r);
+        __m256 ps = _mm256_add_ps(_mm256_set1_ps(S2), _mm256_mul_ps(r2, _mm256_set1_ps(S3)));
+        ps = _mm256_add_ps(_mm256_set1_ps(S1), _mm256_mul_ps(r2, ps));
+        ps = _mm256_add_ps(r, _mm256_mul_ps(_mm256_mul_ps(r2, r), ps));
+        __m256 pc = _mm256_add_ps(_mm256_set1_ps(C2), _mm256_mul_ps(r2, _mm256_set1_ps(C3)));
+        pc = _mm256_add_ps(_mm256_set1_ps(C1), _mm256_mul_ps(r2, pc));
+        pc = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(r2, _mm256_set1_ps(0.5f))),
+                           _mm256_mul_ps(_mm256_mul_ps(r2, r2), pc));
+
+        __m256 swap = _mm256_castsi256_ps(
+            _mm256_cmpeq_epi32(_mm256_and_si256(q, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+        __m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q, _mm256_set1_epi32(2)), 30));
+        __m256 cosSign = _mm256_castsi256_ps(
+            _mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(q, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30));
+        s = _mm256_xor_ps(_mm256_blendv_ps(ps, pc, swap), sinSign);
+        c = _mm256_xor_ps(_mm256_blendv_ps(pc, ps, swap), cosSign);
+    }
+
+    // 8x8 transpose: rows[k] holds element k of 8 matrices; afterwards
+    // rows[m] holds those 8 elements of matrix m
+    __attribute__((target("avx2")))
+    inline void Transpose8(__m256 rows[8]) {
+        __m256 t0 = _mm256_unpacklo_ps(rows[0], rows[1]), t1 = _mm256_unpackhi_ps(rows[0], rows[1]);
+        __m256 t2 = _mm256_unpacklo_ps(rows[2], rows[3]), t3 = _mm256_unpackhi_ps(rows[2], rows[3]);
+        __m256 t4 = _mm256_unpacklo_ps(rows[4], rows[5]), t5 = _mm256_unpackhi_ps(rows[4], rows[5]);
+        __m256 t6 = _mm256_unpacklo_ps(rows[6], rows[7]), t7 = _mm256_unpackhi_ps(rows[6], rows[7]);
+        __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+        rows[0] = _mm256_permute2f128_ps(u0, u4, 0x20);
+        rows[1] = _mm256_permute2f128_ps(u1, u5, 0x20);
+        rows[2] = _mm256_permute2f128_ps(u2, u6, 0x20);
+        rows[3] = _mm256_permute2f128_ps(u3, u7, 0x20);
+        rows[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+        rows[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+        rows[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+        rows[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+    }
+
+    __attribute__((target("avx2")))
+    void ComposeAVX2(const TransformSoA& soa, glm::mat4* out, std::size_t begin, std::size_t end) {
+        const __m256 toRad = _mm256_set1_ps(DegToRad);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const bool aligned = (reinterpret_cast<std::uintptr_t>(out) % 32) == 0;
+
+        std::size_t i = begin;
+        for (; i + 8 <= end; i += 8) {
+            __m256 sa, ca, sb, cb, sc, cc;
+            SinCos256(_mm256_mul_ps(_mm256_loadu_ps(&soa.rx[i]), toRad), sa, ca);
+            SinCos256(_mm256_mul_ps(_mm256_loadu_ps(&soa.ry[i]), toRad), sb, cb);
+            SinCos256(_mm256_mul_ps(_mm256_loadu_ps(&soa.rz[i]), toRad), sc, cc);
+            __m256 sx = _mm256_loadu_ps(&soa.sx[i]), sy = _mm256_loadu_ps(&soa.sy[i]), sz = _mm256_loadu_ps(&soa.sz[i]);
+
+            __m256 sasb = _mm256_mul_ps(sa, sb), casb = _mm256_mul_ps(ca, sb);
+
+            // Elements 0-7 (columns 0-1) and 8-15 (columns 2-3) of 8 matrices
+            __m256 lo[8] = {
+                _mm256_mul_ps(sx, _mm256_mul_ps(cb, cc)),
+                _mm256_mul_ps(sx, _mm256_add_ps(_mm256_mul_ps(sasb, cc), _mm256_mul_ps(ca, sc))),
+                _mm256_mul_ps(sx, _mm256_sub_ps(_mm256_mul_ps(sa, sc), _mm256_mul_ps(casb, cc))),
+                zero,
+                _mm256_mul_ps(sy, _mm256_sub_ps(zero, _mm256_mul_ps(cb, sc))),
+                _mm256_mul_ps(sy, _mm256_sub_ps(_mm256_mul_ps(ca, cc), _mm256_mul_ps(sasb, sc))),
+                _mm256_mul_ps(sy, _mm256_add_ps(_mm256_mul_ps(casb, sc), _mm256_mul_ps(sa, cc))),
+                zero,
+            };
+            __m256 hi[8] = {
+                _mm256_mul_ps(sz, sb),
+                _mm256_mul_ps(sz, _mm256_sub_ps(zero, _mm256_mul_ps(sa, cb))),
+                _mm256_mul_ps(sz, _mm256_mul_ps(ca, cb)),
+                zero,
+                _mm256_loadu_ps(&soa.px[i]), _mm256_loadu_ps(&soa.py[i]), _mm256_loadu_ps(&soa.pz[i]), one,
+            };
+            Transpose8(lo);
+            Transpose8(hi);
+
+            float* dst = reinterpret_cast<float*>(&out[i]);
+            if (aligned) {
+                for (int m = 0; m < 8; ++m) {
+                    _mm256_store_ps(dst + m * 16, lo[m]);
+                    _mm256_store_ps(dst + m * 16 + 8, hi[m]);
+                }
+            } else {
+                for (int m = 0; m < 8; ++m) {
+                    _mm256_storeu_ps(dst + m * 16, lo[m]);
+                    _mm256_storeu_ps(dst + m * 16 + 8, hi[m]);
+                }
+            }
+        }
+        ComposeSSE2(soa, out, i, end);
+    }
+
+#endif  // ZEROG_X86_SIMD
+
+    SimdPath DetectSimdPath() {
+#ifdef ZEROG_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return SimdPath::AVX2;
+        if (__builtin_cpu_supports("sse2")) return SimdPath::SSE2;
+#endif
+        return SimdPath::Scalar;
+    }
+
+}  // namespace
+
+SimdPath ActiveSimdPath() {
+    static const SimdPath path = DetectSimdPath();
+    return path;
+}
+
+const char* SimdPathName(SimdPath path) {
+    switch (path) {
+    case SimdPath::AVX2: return "AVX2";
+    case SimdPath::SSE2: return "SSE2";
+    default: return "scalar";
+    }
+}
+
+void ComposeModelMatrices(const TransformSoA& soa, glm::mat4* out, std::size_t begin, std::size_t end) {
+    end = std::min(end, soa.Size());
+    if (begin >= end) return;
+
+    switch (ActiveSimdPath()) {
+#ifdef ZEROG_X86_SIMD
+    case SimdPath::AVX2: ComposeAVX2(soa, out, begin, end); break;
+    case SimdPath::SSE2: ComposeSSE2(soa, out, begin, end); break;
+#endif
+    default: ComposeScalar(soa, out, begin, end); break;
+    }
+}
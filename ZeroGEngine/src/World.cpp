@@ -0,0 +1,316 @@
+#include "World.hpp"
+#include "CommandBuffer.hpp"
+
+#include <iostream>
+
+static std::uint64_t NextWorldSerial() {
+    static std::atomic<std::uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+World::World() : serial(NextWorldSerial()) {}
+
+World::~World() {
+    // Hand back the mesh references held by live entities
+    for (const Entity& entity : Storage<Entity>()) {
+        MeshTable::Release(entity.mesh);
+    }
+}
+
+// Entity creation
+
+EntityID World::CreateEntity(std::shared_ptr<Mesh> mesh, const std::string& tag) {
+    EntityID newID;
+    if (!freeList.empty()) {
+        std::uint32_t index = freeList.back();
+        freeList.pop_back();
+        newID = MakeEntityID(index, generations[index]);
+    } else {
+        std::uint32_t index = ClaimFreshIndex();
+        if (index == EntityIndexMask) return NullEntity;
+        newID = MakeEntityID(index, 0);
+    }
+
+    CreateReservedEntity(newID, std::move(mesh), tag);
+    return newID;
+}
+
+EntityRange World::CreateEntities(std::uint32_t count, std::shared_ptr<Mesh> mesh, const std::string& tag) {
+    EntityRange range;
+    if (count == 0) return range;
+
+    std::uint32_t first = ClaimFreshRange(count);
+    if (first == EntityIndexMask) return range;
+
+    range.first = MakeEntityID(first, 0);
+    range.count = count;
+
+    EnsureSlot(first + count - 1);
+    MeshHandle meshHandle = MeshTable::Acquire(std::move(mesh), count);
+    TagID tagID = TagTable::Intern(tag);
+    auto& entities = Storage<Entity>();
+    entities.Reserve(entities.Size() + count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        EntityID id = range[i];
+        slots[first + i] = id;
+        SetTag(id, tagID);
+
+        Entity& newEntity = entities.Emplace(id);
+        newEntity.id = id;
+        newEntity.mesh = meshHandle;
+    }
+    return range;
+}
+
+EntityID World::ReserveEntity() {
+    std::uint32_t index = ClaimFreshIndex();
+    return index == EntityIndexMask ? NullEntity : MakeEntityID(index, 0);
+}
+
+bool World::CreateReservedEntity(EntityID id, std::shared_ptr<Mesh> mesh, const std::string& tag) {
+    return CreateReservedEntity(id, std::move(mesh), TagTable::Intern(tag));
+}
+
+bool World::CreateReservedEntity(EntityID id, std::shared_ptr<Mesh> mesh, TagID tag) {
+    if (id == NullEntity) return false;
+
+    std::uint32_t index = EntityIndex(id);
+    EnsureSlot(index);
+    if (slots[index] != NullEntity) return false;
+
+    slots[index] = id;
+    SetTag(id, tag);
+
+    // Register the entity in the entity pool
+    Entity& newEntity = Storage<Entity>().Emplace(id);
+    newEntity.id = id;
+    newEntity.mesh = MeshTable::Acquire(std::move(mesh));
+    return true;
+}
+
+void World::ReleaseReservedIndices(std::uint32_t first, std::uint32_t count) {
+    if (count == 0) return;
+
+    EnsureSlot(first + count - 1);
+    for (std::uint32_t index = first + count; index-- > first;) {
+        if (slots[index] == NullEntity) freeList.push_back(index);
+    }
+}
+
+// Destroy an entity and clean up every component it owns
+void World::DestroyEntity(EntityID id) {
+    if (!HasEntity(id)) return;
+
+    if (const Entity* entity = Storage<Entity>().Read(id)) {
+        MeshTable::Release(entity->mesh);
+    }
+
+    // Only the pools the entity has; types past the mask are probed
+    std::uint32_t index = EntityIndex(id);
+    for (ComponentMask mask = masks[index]; mask != 0; mask &= mask - 1) {
+        pools[__builtin_ctzll(mask)]->Erase(id);
+    }
+    for (std::size_t type = MaskedTypes; type < pools.size(); ++type) {
+        if (pools[type]) pools[type]->Erase(id);
+    }
+
+    // Retire this generation and recycle the index
+    Untag(index);
+    slots[index] = NullEntity;
+    generations[index] = (EntityGeneration(id) + 1) & EntityGenerationMask;
+    freeList.push_back(index);
+}
+
+// Tags
+
+void World::SetTag(EntityID id, TagID tag) {
+    if (!HasEntity(id)) return;
+
+    std::uint32_t index = EntityIndex(id);
+    if (tags[index] == tag) return;
+    Untag(index);
+    if (tag == NoTag) return;
+
+    if (tag >= tagged.size()) tagged.resize(tag + 1);
+    tags[index] = tag;
+    tagSlots[index] = static_cast<std::uint32_t>(tagged[tag].size());
+    tagged[tag].push_back(id);
+}
+
+const std::vector<EntityID>& World::FindByTag(TagID tag) const {
+    static const std::vector<EntityID> none;
+    return tag != NoTag && tag < tagged.size() ? tagged[tag] : none;
+}
+
+// Removes the entity at `index` from its tag's list (swap-and-pop)
+void World::Untag(std::uint32_t index) {
+    TagID tag = tags[index];
+    if (tag == NoTag) return;
+
+    std::vector<EntityID>& members = tagged[tag];
+    std::uint32_t slot = tagSlots[index];
+    EntityID moved = members.back();
+    members[slot] = moved;
+    tagSlots[EntityIndex(moved)] = slot;
+    members.pop_back();
+    tags[index] = NoTag;
+}
+
+// Clear all entities and components
+void World::Clear() {
+    // Bump every live generation so handles from before the clear stay stale.
+    // Reserved-but-not-created indices stay reserved.
+    for (std::uint32_t index = static_cast<std::uint32_t>(slots.size()); index-- > 0;) {
+        EntityID& slot = slots[index];
+        if (slot != NullEntity) {
+            generations[index] = (EntityGeneration(slot) + 1) & EntityGenerationMask;
+            slot = NullEntity;
+            tags[index] = NoTag;
+            freeList.push_back(index);
+        }
+    }
+
+    for (const Entity& entity : Storage<Entity>()) {
+        MeshTable::Release(entity.mesh);
+    }
+
+    for (auto& members : tagged) {
+        members.clear();
+    }
+    for (auto& pool : pools) {
+        if (pool) pool->Clear();
+    }
+}
+
+std::size_t World::MemoryUsage() const {
+    std::size_t bytes = slots.capacity() * sizeof(EntityID) +
+                        (generations.capacity() + freeList.capacity() + tagSlots.capacity()) * sizeof(std::uint32_t) +
+                        tags.capacity() * sizeof(TagID) + masks.capacity() * sizeof(ComponentMask) +
+                        tagged.capacity() * sizeof(tagged[0]);
+    for (const auto& members : tagged) {
+        bytes += members.capacity() * sizeof(EntityID);
+    }
+    for (const auto& pool : pools) {
+        if (pool) bytes += pool->MemoryUsage();
+    }
+    return bytes;
+}
+
+void World::ShrinkToFit() {
+    for (auto& pool : pools) {
+        if (pool) pool->ShrinkToFit();
+    }
+    for (auto& members : tagged) {
+        members.shrink_to_fit();
+    }
+    freeList.shrink_to_fit();
+}
+
+// Claims a never-used index, or EntityIndexMask when the table is full
+std::uint32_t World::ClaimFreshIndex() {
+    return ClaimFreshRange(1);
+}
+
+// Claims `count` consecutive never-used indices and returns the first one,
+// or EntityIndexMask when they don't fit
+std::uint32_t World::ClaimFreshRange(std::uint32_t count) {
+    std::uint32_t index = nextIndex.load(std::memory_order_relaxed);
+    do {
+        if (count > EntityIndexMask - index) {
+            std::cerr << "ECS: entity limit reached (" << EntityIndexMask << ")\n";
+            return EntityIndexMask;
+        }
+    } while (!nextIndex.compare_exchange_weak(index, index + count, std::memory_order_relaxed));
+    return index;
+}
+
+void World::EnsureSlot(std::uint32_t index) {
+    if (index >= slots.size()) {
+        slots.resize(index + 1, NullEntity);
+        generations.resize(index + 1, 0);
+        tags.resize(index + 1, NoTag);
+        tagSlots.resize(index + 1, 0);
+        masks.resize(index + 1, 0);
+    }
+}
+
+// Command buffers
+
+CommandBuffer& World::Commands() {
+    // Per-thread list of (world serial, buffer); serials are never reused, so
+    // a new world at a dead world's address can't pick up its buffer
+    thread_local std::vector<std::pair<std::uint64_t, std::shared_ptr<CommandBuffer>>> local;
+    for (auto& entry : local) {
+        if (entry.first == serial) return *entry.second;
+    }
+
+    // Forget buffers of worlds that have been destroyed
+    for (auto it = local.begin(); it != local.end();) {
+        it = (it->second.use_count() == 1) ? local.erase(it) : it + 1;
+    }
+
+    auto buffer = std::make_shared<CommandBuffer>(*this);
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+        buffers.push_back(buffer);
+    }
+    local.emplace_back(serial, buffer);
+    return *buffer;
+}
+
+void World::FlushCommands() {
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+        for (auto it = buffers.begin(); it != buffers.end();) {
+            (*it)->Playback();
+
+            // Only this world still holds it: its thread has exited
+            if (it->use_count() == 1) {
+                (*it)->ReleaseUnusedIDs();
+                it = buffers.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    DispatchEvents();
+}
+
+bool World::HasPendingCommands() {
+    std::lock_guard<std::mutex> lock(bufferMutex);
+    for (const auto& buffer : buffers) {
+        if (!buffer->Empty()) return true;
+    }
+    return false;
+}
+
+void World::ReleaseCommandIDs() {
+    std::lock_guard<std::mutex> lock(bufferMutex);
+    for (const auto& buffer : buffers) buffer->ReleaseUnusedIDs();
+}
+
+// Observers
+
+void World::RemoveObserver(ObserverID id) {
+    for (auto& set : observers) {
+        if (set && set->Remove(id)) return;
+    }
+}
+
+void World::DispatchEvents() {
+    if (dispatching) return; // called from an observer; the outer loop picks it up
+    dispatching = true;
+
+    // Observers may add or remove components themselves; keep delivering
+    // until quiet, with a cap so a feedback loop can't hang the frame
+    constexpr int MaxRounds = 16;
+    for (int round = 0; round < MaxRounds; ++round) {
+        bool any = false;
+        for (std::size_t type = 0; type < observers.size(); ++type) {
+            if (observers[type] && observers[type]->Dispatch(*this)) any = true;
+        }
+        if (!any) break;
+    }
+
+    dispatching = false;
+}
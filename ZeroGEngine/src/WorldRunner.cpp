@@ -0,0 +1,42 @@
+#include "WorldRunner.hpp"
+#include "ECS.hpp"
+
+#include <chrono>
+
+WorldRunner::WorldRunner(JobSystem& jobs_, StepFn step_) : jobs(jobs_), step(std::move(step_)) {}
+
+World& WorldRunner::AddWorld() {
+    worlds.push_back(std::make_unique<World>());
+    return *worlds.back();
+}
+
+WorldRunner::Report WorldRunner::Run(std::size_t steps, float dt) {
+    auto start = std::chrono::steady_clock::now();
+
+    // One world per job: worlds never share data, so no locking is needed
+    jobs.ParallelFor(worlds.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            World& world = *worlds[i];
+            ECS::WorldScope scope(world);
+            for (std::size_t s = 0; s < steps; ++s) {
+                step(world, i, dt);
+                world.FlushCommands();
+                world.AdvanceTick();
+            }
+        }
+    });
+
+    Report report;
+    report.worlds = worlds.size();
+    report.stepsPerWorld = steps;
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (report.seconds > 0.0) {
+        report.worldStepsPerSecond = static_cast<double>(report.worlds * steps) / report.seconds;
+    }
+    return report;
+}
+
+void WorldRunner::PrintReport(const Report& report, std::ostream& out) {
+    out << "Stepped " << report.worlds << " worlds x " << report.stepsPerWorld << " steps in "
+        << report.seconds << " s (" << report.worldStepsPerSecond << " world-steps/s)\n";
+}
@@ -0,0 +1,319 @@
+#include "WorldSnapshot.hpp"
+
+#include "CameraComponent.hpp"
+#include "HierarchyComponent.hpp"
+#include "TransformComponent.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+    constexpr char Magic[4] = {'Z', 'G', 'S', 'N'};
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t nextIndex;
+        std::uint32_t slotCount;
+        std::uint32_t freeCount;
+        std::uint32_t tagCount;
+        std::uint32_t poolCount;
+    };
+
+    // Bounds-checked read cursor; everything is copied out, since nothing in
+    // the buffer is aligned
+    struct Reader {
+        const std::uint8_t* pos;
+        const std::uint8_t* end;
+
+        const std::uint8_t* Take(std::size_t bytes) {
+            if (static_cast<std::size_t>(end - pos) < bytes) return nullptr;
+            const std::uint8_t* at = pos;
+            pos += bytes;
+            return at;
+        }
+
+        template <typename T>
+        bool Read(T& value) {
+            const std::uint8_t* at = Take(sizeof(T));
+            if (at) std::memcpy(&value, at, sizeof(T));
+            return at != nullptr;
+        }
+
+        template <typename T>
+        bool ReadArray(std::vector<T>& values, std::size_t count) {
+            const std::uint8_t* at = Take(count * sizeof(T));
+            if (!at) return false;
+            values.resize(count);
+            if (count > 0) std::memcpy(values.data(), at, count * sizeof(T));
+            return true;
+        }
+    };
+
+}  // namespace
+
+// Type registry
+
+static std::mutex registryMutex;
+
+std::vector<WorldSnapshot::TypeInfo>& WorldSnapshot::TypeList() {
+    static std::vector<TypeInfo> types = {
+        MakeTypeInfo<Entity>("Entity"),
+        MakeTypeInfo<TransformComponent>("TransformComponent"),
+        MakeTypeInfo<HierarchyComponent>("HierarchyComponent"),
+        MakeTypeInfo<CameraComponent>("CameraComponent"),
+    };
+    return types;
+}
+
+void WorldSnapshot::RegisterType(TypeInfo info) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (TypeInfo& existing : TypeList()) {
+        if (existing.name == info.name) {
+            existing = std::move(info);
+            return;
+        }
+    }
+    TypeList().push_back(std::move(info));
+}
+
+std::vector<WorldSnapshot::TypeInfo> WorldSnapshot::RegisteredTypes() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return TypeList();
+}
+
+// Writing
+
+void WorldSnapshot::Put(Buffer& out, const void* bytes, std::size_t size) {
+    const std::uint8_t* begin = static_cast<const std::uint8_t*>(bytes);
+    out.insert(out.end(), begin, begin + size);
+}
+
+WorldSnapshot WorldSnapshot::Capture(World& world) {
+    std::vector<TypeInfo> types = RegisteredTypes();
+
+    std::size_t estimate = sizeof(Header) + world.slots.size() * 12 + world.freeList.size() * 4;
+    for (const TypeInfo& info : types) {
+        if (info.type < world.pools.size() && world.pools[info.type]) {
+            const PoolBase& pool = *world.pools[info.type];
+            estimate += info.name.size() + 12 + pool.Size() * (sizeof(EntityID) + info.size);
+        }
+    }
+
+    auto out = std::make_shared<Buffer>();
+    out->reserve(estimate);
+
+    // Tags that are in use, by their ID in this process
+    std::vector<TagID> usedTags;
+    for (TagID tag = 1; tag < world.tagged.size(); ++tag) {
+        if (!world.tagged[tag].empty()) usedTags.push_back(tag);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.nextIndex = world.nextIndex.load(std::memory_order_relaxed);
+    header.slotCount = static_cast<std::uint32_t>(world.slots.size());
+    header.freeCount = static_cast<std::uint32_t>(world.freeList.size());
+    header.tagCount = static_cast<std::uint32_t>(usedTags.size());
+    header.poolCount = static_cast<std::uint32_t>(types.size());
+    Put(*out, &header, sizeof(header));
+
+    Put(*out, world.slots.data(), world.slots.size() * sizeof(EntityID));
+    Put(*out, world.generations.data(), world.generations.size() * sizeof(std::uint32_t));
+    Put(*out, world.tags.data(), world.tags.size() * sizeof(TagID));
+    Put(*out, world.freeList.data(), world.freeList.size() * sizeof(std::uint32_t));
+
+    for (TagID tag : usedTags) {
+        const std::string& name = TagTable::Name(tag);
+        std::uint32_t length = static_cast<std::uint32_t>(name.size());
+        Put(*out, &tag, sizeof(tag));
+        Put(*out, &length, sizeof(length));
+        Put(*out, name.data(), name.size());
+    }
+
+    for (const TypeInfo& info : types) {
+        std::uint32_t length = static_cast<std::uint32_t>(info.name.size());
+        std::uint32_t size = static_cast<std::uint32_t>(info.size);
+        Put(*out, &length, sizeof(length));
+        Put(*out, info.name.data(), info.name.size());
+        Put(*out, &size, sizeof(size));
+        info.save(world, *out);
+    }
+
+    return WorldSnapshot(std::move(out));
+}
+
+bool WorldSnapshot::WriteFile(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "WorldSnapshot: cannot open " << path << " for writing\n";
+        return false;
+    }
+    if (data) file.write(reinterpret_cast<const char*>(data->data()), static_cast<std::streamsize>(data->size()));
+    if (!file) {
+        std::cerr << "WorldSnapshot: failed writing " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+std::future<bool> WorldSnapshot::WriteFileAsync(const std::string& path) const {
+    // The copy shares the frozen buffer, which nothing writes to any more
+    WorldSnapshot frozen = *this;
+    return std::async(std::launch::async, [frozen, path]() { return frozen.WriteFile(path); });
+}
+
+WorldSnapshot WorldSnapshot::ReadFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        std::cerr << "WorldSnapshot: cannot open " << path << "\n";
+        return WorldSnapshot();
+    }
+
+    auto in = std::make_shared<Buffer>(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(in->data()), static_cast<std::streamsize>(in->size()));
+    if (!file) {
+        std::cerr << "WorldSnapshot: failed reading " << path << "\n";
+        return WorldSnapshot();
+    }
+    return WorldSnapshot(std::move(in));
+}
+
+// Restoring
+
+bool WorldSnapshot::Restore(World& world) const {
+    if (Empty()) return false;
+    if (world.HasPendingCommands()) {
+        std::cerr << "WorldSnapshot: flush recorded commands before restoring\n";
+        return false;
+    }
+    std::vector<TypeInfo> types = RegisteredTypes();
+
+    // Parse and validate everything before touching the world
+    Reader in{data->data(), data->data() + data->size()};
+    Header header;
+    if (!in.Read(header) || std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+        std::cerr << "WorldSnapshot: not a snapshot\n";
+        return false;
+    }
+    if (header.version != Version) {
+        std::cerr << "WorldSnapshot: version " << header.version << " (expected " << Version << ")\n";
+        return false;
+    }
+
+    std::vector<EntityID> slots;
+    std::vector<std::uint32_t> generations, freeList;
+    std::vector<TagID> tags;
+    bool ok = header.slotCount <= header.nextIndex && header.nextIndex <= EntityIndexMask &&
+              in.ReadArray(slots, header.slotCount) && in.ReadArray(generations, header.slotCount) &&
+              in.ReadArray(tags, header.slotCount) && in.ReadArray(freeList, header.freeCount);
+    for (std::uint32_t index = 0; ok && index < header.slotCount; ++index) {
+        ok = slots[index] == NullEntity || EntityIndex(slots[index]) == index;
+    }
+    for (std::uint32_t index : freeList) {
+        ok = ok && index < header.slotCount && slots[index] == NullEntity;
+    }
+
+    // Snapshot tag IDs -> this process's
+    std::unordered_map<TagID, TagID> tagMap;
+    for (std::uint32_t i = 0; ok && i < header.tagCount; ++i) {
+        TagID tag;
+        std::uint32_t length;
+        const std::uint8_t* name = nullptr;
+        ok = in.Read(tag) && in.Read(length) && (name = in.Take(length)) != nullptr;
+        if (ok) tagMap[tag] = TagTable::Intern(std::string_view(reinterpret_cast<const char*>(name), length));
+    }
+
+    struct Section {
+        const TypeInfo* info;
+        const std::uint8_t* ids;
+        const std::uint8_t* values;
+        std::uint32_t count;
+    };
+    std::vector<Section> sections;
+    std::vector<std::uint8_t> seen;
+    for (std::uint32_t i = 0; ok && i < header.poolCount; ++i) {
+        std::uint32_t length, size, count;
+        const std::uint8_t* name = nullptr;
+        ok = in.Read(length) && (name = in.Take(length)) != nullptr && in.Read(size) && in.Read(count);
+        if (!ok) break;
+
+        Section section{nullptr, in.Take(std::size_t(count) * sizeof(EntityID)), in.Take(std::size_t(count) * size), count};
+        ok = section.ids && section.values;
+        if (!ok) break;
+
+        std::string typeName(reinterpret_cast<const char*>(name), length);
+        for (const TypeInfo& info : types) {
+            if (info.name == typeName) section.info = &info;
+        }
+        if (!section.info || section.info->size != size) {
+            std::cerr << "WorldSnapshot: skipping " << (section.info ? "resized" : "unknown") << " pool '" << typeName << "'\n";
+            continue;
+        }
+
+        // Every component must belong to a distinct live entity
+        seen.assign(header.slotCount, 0);
+        for (std::uint32_t k = 0; ok && k < count; ++k) {
+            EntityID id;
+            std::memcpy(&id, section.ids + k * sizeof(EntityID), sizeof(id));
+            std::uint32_t index = EntityIndex(id);
+            ok = index < header.slotCount && slots[index] == id && !seen[index];
+            if (ok) seen[index] = 1;
+        }
+        sections.push_back(section);
+    }
+    if (!ok) {
+        std::cerr << "WorldSnapshot: snapshot is truncated or corrupt\n";
+        return false;
+    }
+
+    // Take mesh references for the restored entities before Clear() drops the
+    // current ones, so meshes shared by both survive. Handles that are no
+    // longer registered come back as NullMesh.
+    const ComponentTypeID entityType = ECS::ComponentType<Entity>();
+    std::unordered_map<MeshHandle, std::uint32_t> meshRefs;
+    for (const Section& section : sections) {
+        if (section.info->type != entityType) continue;
+        for (std::uint32_t k = 0; k < section.count; ++k) {
+            Entity entity;
+            std::memcpy(&entity, section.values + k * sizeof(Entity), sizeof(Entity));
+            if (entity.mesh != NullMesh) meshRefs[entity.mesh]++;
+        }
+    }
+    std::unordered_map<MeshHandle, bool> meshLive;
+    for (const auto& refs : meshRefs) {
+        meshLive[refs.first] = MeshTable::TryRetain(refs.first, refs.second);
+    }
+
+    // The index space is about to be replaced; blocks claimed under the old
+    // one would hand out IDs that collide with restored entities
+    world.ReleaseCommandIDs();
+    world.Clear();
+
+    world.slots = std::move(slots);
+    world.generations = std::move(generations);
+    world.freeList = std::move(freeList);
+    world.nextIndex.store(header.nextIndex, std::memory_order_relaxed);
+    world.tags.assign(header.slotCount, NoTag);
+    world.tagSlots.assign(header.slotCount, 0);
+    world.masks.assign(header.slotCount, 0);
+    for (std::uint32_t index = 0; index < header.slotCount; ++index) {
+        auto tag = tagMap.find(tags[index]);
+        if (world.slots[index] != NullEntity && tag != tagMap.end()) world.SetTag(world.slots[index], tag->second);
+    }
+
+    for (const Section& section : sections) {
+        section.info->load(world, section.ids, section.values, section.count);
+    }
+
+    for (Entity& entity : world.Storage<Entity>()) {
+        if (entity.mesh != NullMesh && !meshLive.at(entity.mesh)) entity.mesh = NullMesh;
+    }
+    return true;
+}
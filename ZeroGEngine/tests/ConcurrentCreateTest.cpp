@@ -0,0 +1,57 @@
+// 32 threads record entity creates into their own command buffers at once;
+// after one flush every reserved ID must be live and distinct.
+#include "Bench.hpp"
+
+#include "CommandBuffer.hpp"
+#include "ECS.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    constexpr int Threads = 32;
+    constexpr int PerThread = 5000; // not a multiple of IDBlockSize
+
+}  // namespace
+
+int main() {
+    World world;
+    ECS::WorldScope scope(world);
+
+    // A few entities up front so the blocks don't start at index 0
+    for (int i = 0; i < 100; ++i) ECS::CreateEntity();
+
+    std::vector<std::vector<EntityID>> ids(Threads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < Threads; ++t) {
+        threads.emplace_back([&world, &ids, t] {
+            ECS::WorldScope workerScope(world);
+            ids[t].reserve(PerThread);
+            for (int i = 0; i < PerThread; ++i) ids[t].push_back(ECS::Commands().CreateEntity());
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    ECS::FlushCommands();
+
+    std::vector<EntityID> all;
+    for (const auto& list : ids) all.insert(all.end(), list.begin(), list.end());
+    ZG_CHECK(all.size() == std::size_t(Threads) * PerThread);
+    ZG_CHECK(world.EntityCount() == 100 + all.size());
+
+    for (EntityID id : all) {
+        ZG_CHECK(id != NullEntity);
+        ZG_CHECK(world.HasEntity(id));
+    }
+    std::sort(all.begin(), all.end());
+    ZG_CHECK(std::adjacent_find(all.begin(), all.end()) == all.end());
+
+    // The exited threads' buffers are gone and their leftover IDs reusable
+    EntityID next = ECS::CreateEntity();
+    ZG_CHECK(!std::binary_search(all.begin(), all.end(), next));
+
+    std::printf("%d threads x %d creates: %zu unique live entities\n", Threads, PerThread, all.size());
+    return 0;
+}
@@ -1,14 +1,24 @@
 #version 330 core
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aColor;
+layout(location = 2) in mat4 instanceModel; // per instance, 2..5
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// Per-frame camera and lights, shared by every program (std140, binding 0)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+    vec4 lightPos;
+    vec4 lightColor;
+    vec4 ambientColor;
+};
+uniform bool instanced;
 
 out vec3 vertexColor;
 
 void main() {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    mat4 world = instanced ? instanceModel : model;
+    gl_Position = projection * view * world * vec4(aPos, 1.0);
     vertexColor = aColor;
 }
@@ -1,23 +1,158 @@
 #include <glad/glad.h>
 #define GLFW_INCLUDE_NONE
 #include "CameraComponent.hpp"
+#include "CommandBuffer.hpp"
 #include "ECS.hpp"
 #include "EntityBuilder.hpp"
+#include "MeshTable.hpp"
 #include "MeshType.hpp"
 #include "PhysicsSystem.hpp"
+#include "Prefab.hpp"
+#include "ReflectionJSON.hpp"
 #include "Scene.hpp"
+#include "Scheduler.hpp"
+#include "SpatialSort.hpp"
 #include "tinyfiledialogs.h" // ← include file picker
 #include <GLFW/glfw3.h>
 #include <fstream>
 #include <iostream>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <vector>
 
 using json = nlohmann::json;
 
 // Global physics system reference for entity creation
 PhysicsSystem *g_physicsSystem = nullptr;
-void LoadSceneFromJSON(const std::string &filename) {
+
+// Applies an entity (or prefab) definition from a scene file to a builder:
+// mesh, transform, tag, physics and texture
+static void ConfigureBuilder(EntityBuilder &builder, const json &entityJson) {
+  // Mesh
+  std::string meshType = entityJson.value("mesh", "Cube");
+  if (meshType == "Cube") {
+    builder.WithMesh(MeshType::Cube);
+  } else if (meshType == "Pyramid") {
+    builder.WithMesh(MeshType::Pyramid);
+  } else if (meshType == "Sphere") {
+    // Optional "latBands"/"longBands"; equal settings share one mesh
+    MeshParams params;
+    Codec::FromJSON(entityJson, params);
+    builder.WithMesh(MeshType::Sphere, params);
+  }
+
+  // Transform: "position", "rotation" and "scale", each optional
+  TransformComponent transform;
+  Codec::FromJSON(entityJson, transform);
+  builder.WithTransform(transform);
+  const glm::vec3 &scale = transform.scale;
+
+  // Tag
+  std::string tag = entityJson.value("tag", "");
+  builder.WithTag(tag);
+
+  if (entityJson.contains("texture")) {
+    builder.WithTexture(entityJson["texture"].get<std::string>());
+  }
+
+  // Physics
+  if (entityJson.contains("physics")) {
+    const json &physJson = entityJson["physics"];
+    PhysicsOptions opts;
+    opts.restitution = 0.1f; // scene files default to a low bounce
+    Codec::FromJSON(physJson, opts);
+
+    // Mass decides static vs dynamic, whatever "isStatic" says
+    opts.isStatic = opts.mass == 0.0f;
+    if (opts.isStatic) {
+      std::cout << "Creating STATIC body for '" << tag << "' (mass = 0)"
+                << std::endl;
+    } else {
+      std::cout << "Creating DYNAMIC body for '" << tag
+                << "' (mass = " << opts.mass << ")" << std::endl;
+    }
+
+    // Without explicit dimensions the shape follows the entity's scale
+    if (!physJson.contains("dimensions")) {
+      if (opts.shapeType == PhysicsOptions::ShapeType::BOX) {
+        opts.dimensions = scale;
+      } else if (opts.shapeType == PhysicsOptions::ShapeType::SPHERE) {
+        opts.dimensions.x = std::max({scale.x, scale.y, scale.z}) * 0.5f;
+      } else if (opts.shapeType == PhysicsOptions::ShapeType::CAPSULE) {
+        opts.dimensions = glm::vec3(scale.x * 0.5f, scale.y, 0.0f);
+      }
+    }
+
+    std::cout << "  Physics shape: " << Codec::ToJSON(opts)["shape"]
+              << ", dimensions: (" << opts.dimensions.x << ", "
+              << opts.dimensions.y << ", " << opts.dimensions.z << ")"
+              << std::endl;
+
+    builder.WithPhysicsOptions(opts);
+  }
+}
+
+// Entity tagged with the definition's "parent", if it names one that exists
+static EntityID FindParent(const json &entityJson) {
+  if (!entityJson.contains("parent"))
+    return NullEntity;
+
+  std::string parentTag = entityJson["parent"].get<std::string>();
+  const auto &parents = ECS::FindByTag(parentTag);
+  if (parents.empty()) {
+    std::cerr << "Parent '" << parentTag << "' not found for '"
+              << entityJson.value("tag", "") << "'" << std::endl;
+    return NullEntity;
+  }
+  return parents.front();
+}
+
+// Instance count and per-instance step of a prefab entry in a scene file
+struct PrefabSpawn {
+  std::uint32_t count = 1;
+  glm::vec3 offset{0.0f, 0.0f, 0.0f};
+};
+ZG_REFLECT(PrefabSpawn, ZG_FIELD(count), ZG_FIELD(offset));
+
+// Spawns "count" (default 1) instances of a prefab. "position" and "tag"
+// override the prefab's; instance i is moved by i * "offset".
+static std::size_t SpawnPrefabsFromJSON(const PrefabLibrary &prefabs,
+                                        const json &entityJson,
+                                        std::vector<unsigned int> &physicsEntities) {
+  std::string name = entityJson["prefab"].get<std::string>();
+  PrefabSpawn spawn;
+  Codec::FromJSON(entityJson, spawn);
+
+  std::optional<glm::vec3> position;
+  if (entityJson.contains("position")) {
+    TransformComponent placed;
+    Codec::FromJSON(entityJson, placed);
+    position = placed.position;
+  }
+
+  EntityRange spawned = prefabs.Spawn(
+      name, spawn.count, [&](std::size_t i, EntityID, TransformComponent &t) {
+        if (position)
+          t.position = *position;
+        t.position += spawn.offset * static_cast<float>(i);
+      });
+
+  EntityID parent = FindParent(entityJson);
+  for (std::size_t i = 0; i < spawned.Size(); ++i) {
+    if (entityJson.contains("tag"))
+      ECS::SetTag(spawned[i], entityJson["tag"].get<std::string>());
+    if (parent != NullEntity)
+      ECS::SetParent(spawned[i], parent);
+    if (ECS::HasPhysics(spawned[i]))
+      physicsEntities.push_back(spawned[i]);
+  }
+
+  std::cout << "Spawned " << spawned.Size() << " x prefab '" << name << "'"
+            << std::endl;
+  return spawned.Size();
+}
+
+void LoadSceneFromJSON(const std::string &filename, PrefabLibrary &prefabs) {
   std::ifstream file(filename);
   if (!file.is_open()) {
     std::cerr << "Failed to open scene file: " << filename << "\n";
@@ -34,23 +169,20 @@ void LoadSceneFromJSON(const std::string &filename) {
 
   // Load camera
   if (sceneJson.contains("camera")) {
-    auto camJson = sceneJson["camera"];
-    auto pos = camJson.value("position", std::vector<float>{0.0f, 0.0f, 5.0f});
-    auto rot = camJson.value("rotation", std::vector<float>{0.0f, 0.0f, 0.0f});
-    float fov = camJson.value("fov", 60.0f);
-
-    std::cout << "Creating camera: pos(" << pos[0] << ", " << pos[1] << ", "
-              << pos[2] << ") "
-              << "rot(" << rot[0] << ", " << rot[1] << ", "
-              << (rot.size() > 2 ? rot[2] : 0.0f) << ") "
-              << "fov(" << fov << ")" << std::endl;
+    // Scene-file defaults, overridden by "position", "rotation", "fov"...
+    CameraComponent camera(60.0f, glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0.0f));
+    Codec::FromJSON(sceneJson["camera"], camera);
+    camera.updateFront();
 
-    glm::vec3 position{pos[0], pos[1], pos.size() > 2 ? pos[2] : 0.f};
-    glm::vec3 rotation{rot[0], rot[1], rot.size() > 2 ? rot[2] : 0.f};
+    std::cout << "Creating camera: pos(" << camera.position.x << ", "
+              << camera.position.y << ", " << camera.position.z << ") "
+              << "rot(" << camera.rotation.x << ", " << camera.rotation.y
+              << ", " << camera.rotation.z << ") "
+              << "fov(" << camera.fov << ")" << std::endl;
 
     EntityBuilder builder;
     builder.WithTag("MainCamera");
-    builder.WithCamera(CameraComponent(fov, position, rotation));
+    builder.WithCamera(camera);
     auto cameraId = builder.Build();
 
     std::cout << "Camera created with ID: " << cameraId << std::endl;
@@ -63,123 +195,33 @@ void LoadSceneFromJSON(const std::string &filename) {
     }
   }
 
+  // Prefabs: named entity definitions, resolved once and spawned by
+  // entities that say "prefab": "<name>"
+  if (sceneJson.contains("prefabs")) {
+    for (const auto &[name, prefabJson] : sceneJson["prefabs"].items()) {
+      EntityBuilder builder;
+      ConfigureBuilder(builder, prefabJson);
+      prefabs.Define(name, builder.BuildPrefab());
+    }
+    std::cout << "Defined " << prefabs.Size() << " prefabs." << std::endl;
+  }
+
   // Load entities
   if (sceneJson.contains("entities")) {
     int entityCount = 0;
     for (const auto &entityJson : sceneJson["entities"]) {
-      EntityBuilder builder;
-
-      // Mesh
-     
-// Mesh
-std::string meshType = entityJson.value("mesh", "Cube");
-if (meshType == "Cube") {
-    builder.WithMesh(MeshType::Cube);
-} else if (meshType == "Pyramid") {
-    builder.WithMesh(MeshType::Pyramid);
-} else if (meshType == "Sphere") {
-    builder.WithMesh(MeshType::Sphere); // Add this
-}
-
-
-      // Position
-      auto pos =
-          entityJson.value("position", std::vector<float>{0.0f, 0.0f, 0.0f});
-      builder.WithPosition(pos[0], pos[1], pos.size() > 2 ? pos[2] : 0.f);
-
-      // Scale
-      auto scale =
-          entityJson.value("scale", std::vector<float>{1.0f, 1.0f, 1.0f});
-      builder.WithScale(scale[0], scale[1], scale.size() > 2 ? scale[2] : 1.f);
-
-      // Tag
-      std::string tag = entityJson.value("tag", "");
-      builder.WithTag(tag);
-
-      // Physics - FIXED LOGIC
-      if (entityJson.contains("physics")) {
-        auto physJson = entityJson["physics"];
-        PhysicsOptions opts;
-
-        // Mass determines if static or dynamic
-        float mass = physJson.value("mass", 1.0f);
-        opts.mass = mass;
-
-        // CRITICAL FIX: If mass is 0, force static regardless of JSON
-        if (mass == 0.0f) {
-          opts.isStatic = true;
-          std::cout << "Creating STATIC body for '" << tag << "' (mass = 0)"
-                    << std::endl;
-        } else {
-          opts.isStatic = false; // Force dynamic for non-zero mass
-          std::cout << "Creating DYNAMIC body for '" << tag
-                    << "' (mass = " << mass << ")" << std::endl;
-        }
-
-        // Friction/restitution
-        opts.staticFriction = physJson.value("staticFriction", 0.5f);
-        opts.dynamicFriction = physJson.value("dynamicFriction", 0.5f);
-        opts.restitution = physJson.value("restitution", 0.1f);
-
-        // Shape type
-        std::string shapeStr = physJson.value("shape", "box");
-        if (shapeStr == "box") {
-          opts.shapeType = PhysicsOptions::ShapeType::BOX;
-        } else if (shapeStr == "sphere") {
-          opts.shapeType = PhysicsOptions::ShapeType::SPHERE;
-        } else if (shapeStr == "capsule") {
-          opts.shapeType = PhysicsOptions::ShapeType::CAPSULE;
-        }
-
-if (entityJson.contains("texture")) {
-    std::string texturePath = entityJson["texture"];
-    builder.WithTexture(texturePath);
-}
-        // Dimensions - CRITICAL FIX
-        if (physJson.contains("dimensions")) {
-          auto dims = physJson["dimensions"].get<std::vector<float>>();
-          if (opts.shapeType == PhysicsOptions::ShapeType::BOX) {
-            if (dims.size() >= 3) {
-              opts.dimensions = glm::vec3(dims[0], dims[1], dims[2]);
-            } else {
-              opts.dimensions = glm::vec3(scale[0], scale[1], scale[2]);
-            }
-          } else if (opts.shapeType == PhysicsOptions::ShapeType::SPHERE) {
-            if (!dims.empty()) {
-              opts.dimensions.x = dims[0]; // radius
-            } else {
-              opts.dimensions.x =
-                  std::max({scale[0], scale[1], scale[2]}) * 0.5f;
-            }
-          } else if (opts.shapeType == PhysicsOptions::ShapeType::CAPSULE) {
-            if (dims.size() >= 2) {
-              opts.dimensions =
-                  glm::vec3(dims[0], dims[1], 0.0f); // radius, height
-            } else {
-              opts.dimensions = glm::vec3(scale[0] * 0.5f, scale[1], 0.0f);
-            }
-          }
-        } else {
-          // Use scale as dimensions for all shapes
-          if (opts.shapeType == PhysicsOptions::ShapeType::BOX) {
-            opts.dimensions = glm::vec3(scale[0], scale[1], scale[2]);
-          } else if (opts.shapeType == PhysicsOptions::ShapeType::SPHERE) {
-            opts.dimensions.x = std::max({scale[0], scale[1], scale[2]}) * 0.5f;
-          } else if (opts.shapeType == PhysicsOptions::ShapeType::CAPSULE) {
-            opts.dimensions = glm::vec3(scale[0] * 0.5f, scale[1], 0.0f);
-          }
-        }
-
-        std::cout << "  Physics shape: " << shapeStr << ", dimensions: ("
-                  << opts.dimensions.x << ", " << opts.dimensions.y << ", "
-                  << opts.dimensions.z << ")" << std::endl;
-
-        builder.WithPhysicsOptions(opts);
+      if (entityJson.contains("prefab")) {
+        entityCount += SpawnPrefabsFromJSON(prefabs, entityJson, physicsEntities);
+        continue;
       }
 
+      EntityBuilder builder;
+      ConfigureBuilder(builder, entityJson);
+      builder.WithParent(FindParent(entityJson));
+
       auto entityId = builder.Build();
       entityCount++;
-      std::cout << "Created entity '" << tag << "' with ID: " << entityId
+      std::cout << "Created entity '" << ECS::GetTag(entityId) << "' with ID: " << entityId
                 << std::endl;
 
       // If entity has physics, add to our list for PhysX actor creation
@@ -251,9 +293,12 @@ int main() {
 
   glEnable(GL_DEPTH_TEST);
 
+  // Worker pool shared by the system scheduler and PhysX; must outlive both
+  JobSystem jobs;
+
   // Initialize physics system first
   PhysicsSystem physicsSystem;
-  physicsSystem.Init();
+  physicsSystem.Init(&jobs);
   g_physicsSystem = &physicsSystem; // Set global reference for scene loading
 
   std::cout << "Physics system initialized." << std::endl;
@@ -269,48 +314,91 @@ int main() {
     return 0;
   }
 
-  LoadSceneFromJSON(file);
+  // Templates from the scene file; owns their meshes, so it is cleared
+  // before the GL context goes away
+  PrefabLibrary prefabs;
+  LoadSceneFromJSON(file, prefabs);
+
+  // The scene's renderer owns GL objects; the scene and the systems that
+  // capture it live in this block so they are destroyed before the context
+  {
+    Scene scene;
+
+    std::cout << "Starting render loop... Press ESC to exit" << std::endl;
+
+    const float fixedDeltaTime = 1.0f / 60.0f; // fixed 60 Hz physics
+    float accumulator = 0.0f;
+
+    // Systems declare what they touch; the scheduler orders conflicting ones
+    // and runs the rest concurrently
+    Scheduler scheduler(jobs);
+    scheduler
+        .AddSystem("Physics",
+                   [&](float frameTime) {
+                     accumulator += frameTime;
+
+                     // Fixed physics step using FixedUpdate
+                     while (accumulator >= fixedDeltaTime) {
+                       physicsSystem.FixedUpdate(fixedDeltaTime); // PhysX simulation step
+                       accumulator -= fixedDeltaTime;
+                     }
+                   })
+        .Reads<Entity>()
+        .Writes<TransformComponent, PhysicsComponent>();
+    scheduler
+        .AddSystem("Render",
+                   [&](float) {
+                     glClearColor(0.12f, 0.12f, 0.12f, 1.f);
+                     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                     scene.Render(&jobs);
+                   })
+        .Reads<Entity, TransformComponent, HierarchyComponent, CameraComponent>()
+        .OnMainThread();
+    scheduler.PrintStages(std::cout);
+
+    // Keeps transforms (and the pools walked alongside them) in Z-order
+    SpatialSort spatialSort(ECS::CurrentWorld());
+    spatialSort.Follow<Entity>().Follow<PhysicsComponent>();
+
+    double lastTime = glfwGetTime();
+
+    while (!glfwWindowShouldClose(window)) {
+      if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
+        glfwSetWindowShouldClose(window, GLFW_TRUE);
+      }
 
-  Scene scene;
+      double currentTime = glfwGetTime();
+      float frameTime = static_cast<float>(currentTime - lastTime);
+      lastTime = currentTime;
 
-  std::cout << "Starting render loop... Press ESC to exit" << std::endl;
+      // Cap frame time to prevent spiral of death
+      frameTime = std::min(frameTime, 0.25f);
 
-  const float fixedDeltaTime = 1.0f / 60.0f; // fixed 60 Hz physics
-  float accumulator = 0.0f;
+      // Systems read camera matrices concurrently; rebuild them beforehand
+      ECS::RefreshCameras();
 
-  double lastTime = glfwGetTime();
+      scheduler.Run(frameTime);
 
-  while (!glfwWindowShouldClose(window)) {
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
-      glfwSetWindowShouldClose(window, GLFW_TRUE);
-    }
+      // Apply entity creates/destroys recorded by systems this frame
+      ECS::FlushCommands();
 
-    double currentTime = glfwGetTime();
-    float frameTime = static_cast<float>(currentTime - lastTime);
-    lastTime = currentTime;
+      // Delete GL objects of meshes released this frame, on the context thread
+      MeshTable::CollectGarbage();
 
-    // Cap frame time to prevent spiral of death
-    frameTime = std::min(frameTime, 0.25f);
+      // A slice of the spatial reordering pass, while no system is iterating
+      spatialSort.Step();
 
-    accumulator += frameTime;
+      // Changes made from here on belong to the next frame
+      ECS::CurrentWorld().AdvanceTick();
 
-    // Fixed physics step using FixedUpdate
-    while (accumulator >= fixedDeltaTime) {
-      physicsSystem.FixedUpdate(fixedDeltaTime); // PhysX simulation step
-      accumulator -= fixedDeltaTime;
+      glfwSwapBuffers(window);
+      glfwPollEvents();
     }
-
-    // Normal rendering
-    glClearColor(0.12f, 0.12f, 0.12f, 1.f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    scene.Render();
-
-    glfwSwapBuffers(window);
-    glfwPollEvents();
   }
 
   // Clean up
+  prefabs.Clear();
+  MeshTable::CollectGarbage();
 
   glfwDestroyWindow(window);
   glfwTerminate();